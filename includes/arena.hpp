@@ -0,0 +1,116 @@
+#ifndef DA_PROJ1_ARENA_H
+#define DA_PROJ1_ARENA_H
+
+class Arena;
+class ArenaScope;
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Monotonic memory resource for the state of a single scenario run.
+ *
+ * @details Memory is handed out by bumping a pointer through a few big blocks
+ *          and is never given back one allocation at a time, only all at once
+ *          by reset(). The blocks themselves are kept, so once a run of some
+ *          size has happened, runs up to that size don't allocate any memory
+ *          from the heap.
+ *
+ *          Each thread has its own arena, see local(), so runs on different
+ *          threads never share one.
+ */
+class Arena : public std::pmr::memory_resource {
+    /** @brief A block of memory taken from the heap. */
+    struct Block {
+        /** @brief The start of the block. */
+        std::byte *data;
+        /** @brief How many bytes the block has. */
+        size_t size;
+    };
+
+    /** @brief Every block, with the one being used last. */
+    std::vector<Block> blocks;
+    /** @brief Where the next allocation may start. */
+    std::byte *next{nullptr};
+    /** @brief The end of the block being used. */
+    std::byte *end{nullptr};
+
+    /**
+     * @brief Takes a new block from the heap and starts using it.
+     *
+     * @param size How many bytes the block must have, at least.
+     */
+    void grow(size_t size);
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const memory_resource &other) const noexcept override;
+
+public:
+    /** @brief How much of an arena was used at some point, see mark(). */
+    struct Mark {
+        /** @brief How many blocks there were. */
+        size_t blocks;
+        /** @brief Where the next allocation would have started. */
+        std::byte *next;
+    };
+
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena() override;
+
+    /** @return The arena of the calling thread. */
+    static Arena &local();
+
+    /**
+     * @brief Frees everything that was allocated, keeping the memory for the
+     *        next allocations.
+     *
+     * @details If the last run needed more than one block, they are replaced
+     *          with a single block as big as all of them.
+     */
+    void reset();
+
+    /** @return How much of the arena is used right now. */
+    Mark mark() const;
+
+    /**
+     * @brief Frees everything that was allocated since a mark was taken.
+     *
+     * @details The blocks taken since then are given back to the heap. A mark
+     *          taken while nothing was allocated is the same as reset().
+     *
+     * @param mark The mark, taken from this arena after any mark still in use
+     *             that was taken before it.
+     */
+    void release(const Mark &mark);
+
+    /** @return How many bytes the arena holds, used or not. */
+    size_t capacity() const;
+};
+
+/**
+ * @brief Frees what was allocated from the arena of the calling thread while
+ *        it existed when it goes out of scope.
+ *
+ * @details The outermost scope resets the arena, see Arena::reset(), and
+ *          nested scopes only free their own allocations, see
+ *          Arena::release().
+ *
+ * @note Nothing allocated from the arena while it exists may outlive it.
+ */
+class ArenaScope {
+    /** @brief How much of the arena was used when the scope was created. */
+    Arena::Mark mark;
+
+public:
+    ArenaScope();
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+    ~ArenaScope();
+};
+
+#endif // DA_PROJ1_ARENA_H
@@ -0,0 +1,67 @@
+#ifndef DA_PROJ1_CLI_H
+#define DA_PROJ1_CLI_H
+
+struct SolveParams;
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Options of the solve command, see solve().
+ */
+struct SolveParams {
+    /** @brief The dataset to load, relative to ::DATASETS_PATH. */
+    std::string dataset{"default"};
+    /** @brief The number of the scenario to run, from 1 to 3. */
+    int scenario{1};
+    /** @brief The value of the strategy of the scenario to run. */
+    int strategy{1};
+    /**
+     * @brief How many threads to use, 0 to use one per core. Can't be given
+     *        as 0, one per core is used when it isn't given.
+     */
+    unsigned int threads{0};
+    /**
+     * @brief How long strategies with a time budget may run, see
+     *        ScenarioOptions#timeBudget.
+     */
+    std::optional<std::chrono::milliseconds> budget{};
+    /** @brief Where to write the result, or empty for the standard output. */
+    std::string out{};
+    /** @brief Whether the result may be taken from the ResultCache. */
+    bool cache{true};
+};
+
+/**
+ * @brief Parses the options of the solve command.
+ *
+ * @details Strategies are given by the name of their enumerator, such as
+ *          AREA_DESC, and must belong to the given scenario. Numbers must
+ *          take up the whole argument, in decimal, and the thread count can't
+ *          be 0 or negative.
+ *
+ * @param argc The number of arguments, starting with the command itself.
+ * @param argv The arguments.
+ *
+ * @return The options, or nothing if they are invalid.
+ */
+std::optional<SolveParams> parseSolveArguments(int argc, char **argv);
+
+/**
+ * @brief Runs the solve command: loads a dataset, runs a scenario on it and
+ *        writes the result as csv, in the same format as runAllScenarios().
+ *
+ * @details Nothing is read from the terminal and nothing but the result, if
+ *          it isn't written to a file, or errors are written to it, so the
+ *          command can be used in scripts.
+ *
+ * @param program The name the program was run with, for the usage line.
+ * @param argc The number of arguments, starting with the command itself.
+ * @param argv The arguments.
+ *
+ * @return The exit code of the program.
+ */
+int solve(const char *program, int argc, char **argv);
+
+#endif // DA_PROJ1_CLI_H
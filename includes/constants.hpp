@@ -1,6 +1,8 @@
 #ifndef DA_PROJ1_CONSTANTS_H
 #define DA_PROJ1_CONSTANTS_H
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 /**
@@ -11,12 +13,24 @@ extern std::string DATASETS_PATH;
  * @brief Where the scenario results will be stored in the datasets folder.
  */
 const std::string OUTPUT_FILE = "output.csv";
+/**
+ * @brief Where the time spent in each phase of each scenario run, and the
+ *        counters of the run, will be stored in the datasets folder. Only
+ *        written when built with INSTRUMENTATION defined.
+ */
+const std::string INSTRUMENTATION_FILE = "instrumentation.csv";
 /**
  * @brief The header to be printed at the start of the scenario results.
  */
 const std::string OUTPUT_HEADER =
     "dataset,scenario,heuristic,usedvans,ordersdispatched,remainingorders,"
-    "efficiency,avgdeliverytime,cost,reward,profit,runtime\n";
+    "efficiency,avgdeliverytime,cost,reward,profit,runtime,gap,cached\n";
+/**
+ * @brief The header to be printed at the start of the benchmark results.
+ */
+const std::string BENCH_HEADER =
+    "orders,vans,scenario,heuristic,runs,medianus,p99us,orderspersecond,"
+    "allocationsperrun\n";
 /**
  * @brief Where the vans are stored in a dataset folder.
  */
@@ -33,6 +47,109 @@ const std::string ORDERS_FILE = "/encomendas.txt";
  * @brief The header to be printed at the start of a file containing orders.
  */
 const std::string ORDERS_HEADER = "volume peso recompensa duração(s)\n";
+/**
+ * @brief Where the binary version of a dataset is stored in a dataset folder.
+ */
+const std::string BINARY_FILE = "/dataset.bin";
+/**
+ * @brief Where the hash of a dataset is kept in a dataset folder, as a little
+ *        endian 8 byte integer, so its results can be found without loading
+ *        it.
+ */
+const std::string HASH_FILE = "/dataset.hash";
+/**
+ * @brief The bytes a binary dataset file starts with.
+ */
+const std::string BINARY_MAGIC = "DAP1";
+/**
+ * @brief The version of the binary dataset format.
+ *
+ * @note Must be increased whenever the layout of the binary file changes.
+ */
+const uint32_t BINARY_VERSION = 1;
+/**
+ * @brief How long a work day lasts, in seconds.
+ */
+const uint32_t WORK_DAY_DURATION = 8 * 3600;
+/**
+ * @brief The most bytes scenario3() may use to remember which orders it picked
+ *        with Scenario3Strategy::MAX_REWARD. Past that, the orders are split
+ *        in halves that are solved one at a time.
+ */
+const size_t SCENARIO3_MAX_TABLE_SIZE = 64 * 1024 * 1024;
+/**
+ * @brief How many times a PackingSession may look for another van for an
+ *        order in the way of one that doesn't fit anywhere. Each look that
+ *        fails may visit every van.
+ */
+const size_t PACKING_SESSION_REPAIR_BUDGET = 16;
+/**
+ * @brief How many bytes packOrderStream() reads at a time.
+ */
+const size_t ORDER_STREAM_CHUNK_SIZE = 1024 * 1024;
+/**
+ * @brief How many chunks of orders packOrderStream() may have read ahead of
+ *        the ones being packed.
+ */
+const size_t ORDER_STREAM_QUEUE_SIZE = 4;
+/**
+ * @brief The smallest block of memory an Arena takes from the heap.
+ */
+const size_t ARENA_MIN_BLOCK_SIZE = 64 * 1024;
+/**
+ * @brief How many rows of a dataset file generateColumns() generates as a
+ *        single block, with its own stream of random numbers.
+ */
+const size_t GENERATOR_BLOCK_SIZE = 64 * 1024;
+/**
+ * @brief How many bytes a FileWriter gathers before writing them to its file.
+ */
+const size_t FILE_WRITER_BUFFER_SIZE = 1024 * 1024;
+/**
+ * @brief How long Scenario1Strategy::MULTI_START and
+ *        Scenario2Strategy::MULTI_START keep starting new runs, unless
+ *        ScenarioOptions#timeBudget says otherwise.
+ */
+const std::chrono::milliseconds MULTI_START_TIME_BUDGET{100};
+/**
+ * @brief The most runs Scenario1Strategy::MULTI_START and
+ *        Scenario2Strategy::MULTI_START may make.
+ */
+const size_t MULTI_START_MAX_STARTS = 64;
+/**
+ * @brief How far ahead, as a fraction of the number of orders or vans, an
+ *        order or van may move when a multi start run shuffles them.
+ */
+const double MULTI_START_NOISE = 0.05;
+/**
+ * @brief How long a LocalSearch keeps trying to empty vans, unless
+ *        ScenarioOptions#timeBudget says otherwise.
+ */
+const std::chrono::milliseconds LOCAL_SEARCH_TIME_BUDGET{100};
+/**
+ * @brief How many orders of other vans a LocalSearch checks for a swap before
+ *        giving up on an order that doesn't fit anywhere else.
+ */
+const size_t LOCAL_SEARCH_SWAP_TRIES = 256;
+/**
+ * @brief Where a ResultCache keeps its results on disk, relative to
+ *        ::DATASETS_PATH.
+ */
+const std::string RESULT_CACHE_PATH = "../cache/";
+/**
+ * @brief Whether a ResultCache keeps its results on disk, so they are kept
+ *        between runs of the program.
+ */
+const bool RESULT_CACHE_ON_DISK = true;
+/**
+ * @brief Version of the results a ResultCache keeps on disk. Must be changed
+ *        whenever a strategy changes what it returns.
+ */
+const uint32_t RESULT_CACHE_VERSION = 3;
+/**
+ * @brief How many results a ResultCache keeps in memory.
+ */
+const size_t RESULT_CACHE_MAX_ENTRIES = 64;
 /**
  * @brief How many items to print in each page in UserInterface#paginatedMenu().
  */
@@ -4,10 +4,13 @@
 struct DatasetGenerationParams;
 class Dataset;
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "order.hpp"
+#include "ordertable.hpp"
 #include "van.hpp"
 
 /**
@@ -56,6 +59,13 @@ struct DatasetGenerationParams {
     unsigned int minVanCost{0};
     /** @brief The maximum amount vans will cost. */
     unsigned int maxVanCost{1000};
+
+    /**
+     * @brief The seed of the random number generators.
+     *
+     * @details The same parameters and seed always generate the same dataset.
+     */
+    uint64_t seed{0};
 };
 
 /**
@@ -67,7 +77,9 @@ class Dataset {
     /** @brief The vans associated with this dataset. */
     std::vector<Van> vans;
     /** @brief The orders associated with this dataset. */
-    std::vector<Order> orders;
+    OrderTable orders;
+    /** @brief A hash of #orders and #vans. */
+    uint64_t hash;
 
     /**
      * @brief Creates a new dataset from the given orders and vans.
@@ -75,17 +87,64 @@ class Dataset {
      * @param orders The orders to associate with this dataset.
      * @param vans The vans to associate with this dataset.
      */
-    Dataset(const std::vector<Order> &orders, const std::vector<Van> &vans);
+    Dataset(OrderTable orders, std::vector<Van> vans);
+
+    /**
+     * @brief Loads a dataset from its text files.
+     *
+     * @note The path must be relative to ::DATASETS_PATH.
+     *
+     * @param path The folder where the dataset is.
+     *
+     * @return The dataset that was loaded.
+     */
+    static Dataset loadText(const std::string &path);
+
+    /**
+     * @brief Loads a dataset from its binary file.
+     *
+     * @details The file is memory mapped and its columns are copied straight
+     *          into the dataset, without any parsing.
+     *
+     * @note The path must be relative to ::DATASETS_PATH.
+     *
+     * @param path The folder where the dataset is.
+     *
+     * @return The dataset that was loaded.
+     * @return Nothing if the file doesn't exist or isn't valid.
+     */
+    static std::optional<Dataset> loadBinary(const std::string &path);
+
+    /**
+     * @brief Checks if the binary file of a dataset is up to date.
+     *
+     * @note The path must be relative to ::DATASETS_PATH.
+     *
+     * @param path The folder where the dataset is.
+     *
+     * @return Whether the binary file exists and is newer than the text
+     *         files.
+     */
+    static bool isBinaryUpToDate(const std::string &path);
 
 public:
     /** @return The vans associated with this dataset. */
     const std::vector<Van> &getVans() const;
     /** @return The orders associated with this dataset. */
-    const std::vector<Order> &getOrders() const;
+    const OrderTable &getOrders() const;
+    /**
+     * @return A hash of the orders and vans of this dataset, the same for
+     *         every dataset with the same contents. See xxHash64().
+     */
+    uint64_t getHash() const;
 
     /**
      * @brief Loads a dataset from the given path.
      *
+     * @details Uses the binary file (::BINARY_FILE) if it is up to date, and
+     *          the text files otherwise. The hash of the dataset is kept in
+     *          ::HASH_FILE.
+     *
      * @note The path must be relative to ::DATASETS_PATH.
      *
      * @param path The folder where the dataset is.
@@ -94,10 +153,32 @@ public:
      */
     static Dataset load(const std::string &path);
 
+    /**
+     * @brief Converts the text files of a dataset to a single binary file.
+     *
+     * @details The binary file (::BINARY_FILE) starts with a header holding
+     *          ::BINARY_MAGIC, ::BINARY_VERSION and the number of orders and
+     *          vans, as little endian integers of 4, 4, 8 and 8 bytes. It is
+     *          followed by the volume, weight, reward and duration of every
+     *          order, and then by the max volume, max weight and cost of every
+     *          van, one column at a time, as little endian 4 byte integers.
+     *
+     * @note The path must be relative to ::DATASETS_PATH.
+     *
+     * @param path The folder where the dataset is.
+     *
+     * @return Whether the binary file was written.
+     */
+    static bool convertToBinary(const std::string &path);
+
     /**
      * @brief Generates a new dataset from pseudo random data and stores it in a
      *        folder.
      *
+     * @details If there was a dataset in the folder, its results are removed
+     *          from the ResultCache, using the hash kept in ::HASH_FILE when it
+     *          was last loaded, so it isn't loaded again.
+     *
      * @param name The folder where the dataset will be stored.
      * @param params The parameters given to the random number generators.
      *
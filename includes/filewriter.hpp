@@ -0,0 +1,122 @@
+#ifndef DA_PROJ1_FILEWRITER_H
+#define DA_PROJ1_FILEWRITER_H
+
+class FileWriter;
+
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <fstream>
+#endif
+
+/**
+ * @brief Writes text to a file, or to memory, formatting numbers without
+ *        going through a stream.
+ *
+ * @details Numbers are formatted with std::to_chars straight into a buffer,
+ *          which is written to the file with a single call once it holds
+ *          ::FILE_WRITER_BUFFER_SIZE bytes, and then reused. Text bigger than
+ *          the buffer is written without being copied into it.
+ *
+ *          Without a file, everything stays in the buffer, so the rows of a
+ *          file can be formatted on different threads and written in order
+ *          afterwards.
+ */
+class FileWriter {
+    /** @brief The text that wasn't written yet. */
+    std::string buffer{};
+    /** @brief Whether everything was written successfully so far. */
+    bool ok{true};
+#ifdef _WIN32
+    /** @brief The file being written. */
+    std::ofstream file{};
+#else
+    /** @brief The descriptor of the file being written, or -1 for none. */
+    int fd{-1};
+#endif
+
+    /** @return Whether the text is written to a file. */
+    bool hasFile() const;
+    /** @brief Writes the buffer to the file if it is full. */
+    void flushIfFull();
+
+    /**
+     * @brief Writes some text straight to the file, which must exist.
+     *
+     * @param text The text.
+     */
+    void writeToFile(std::string_view text);
+
+public:
+    /** @brief Creates a writer that keeps everything in memory. */
+    FileWriter() = default;
+    /**
+     * @brief Creates or truncates a file and writes to it.
+     *
+     * @param path The path to the file.
+     */
+    explicit FileWriter(const std::string &path);
+    FileWriter(const FileWriter &) = delete;
+    FileWriter &operator=(const FileWriter &) = delete;
+    /** @brief Writes what is left in the buffer and closes the file. */
+    ~FileWriter();
+
+    /** @return Whether the file was opened and written successfully so far. */
+    bool good() const;
+    /** @return The text that wasn't written to a file yet. */
+    std::string_view getContents() const;
+
+    /** @brief Writes the buffer to the file. */
+    void flush();
+
+    /**
+     * @brief Writes some text.
+     *
+     * @param text The text.
+     *
+     * @return This writer.
+     */
+    FileWriter &operator<<(std::string_view text);
+    /**
+     * @brief Writes a character.
+     *
+     * @param c The character.
+     *
+     * @return This writer.
+     */
+    FileWriter &operator<<(char c);
+    /**
+     * @brief Writes a floating point number, with the same format a stream
+     *        uses by default.
+     *
+     * @param value The number.
+     *
+     * @return This writer.
+     */
+    FileWriter &operator<<(double value);
+
+    /**
+     * @brief Writes an integer.
+     *
+     * @param value The integer.
+     *
+     * @return This writer.
+     */
+    template <std::integral T>
+        requires(!std::same_as<T, char> && !std::same_as<T, bool>)
+    FileWriter &operator<<(T value) {
+        // Enough for any 64 bit integer and its sign
+        char digits[24];
+        char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+
+        buffer.append(digits, end);
+        flushIfFull();
+
+        return *this;
+    }
+};
+
+#endif // DA_PROJ1_FILEWRITER_H
@@ -0,0 +1,31 @@
+#ifndef DA_PROJ1_FITMASK_H
+#define DA_PROJ1_FITMASK_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief How many vans fitMask() checks at once.
+ */
+const size_t FIT_MASK_WIDTH = 16;
+
+/**
+ * @brief Checks in which of a group of vans an order can fit.
+ *
+ * @details Uses AVX2 or SSE2 instructions when the processor supports them,
+ *          which is checked once when the program starts, and plain
+ *          comparisons otherwise.
+ *
+ * @param volumes How much volume each van has left. Must hold at least
+ *                ::FIT_MASK_WIDTH values.
+ * @param weights How much weight each van has left. Must hold at least
+ *                ::FIT_MASK_WIDTH values.
+ * @param vol The volume of the order.
+ * @param w The weight of the order.
+ *
+ * @return A mask where bit \f$i\f$ is set if the order fits in van \f$i\f$.
+ */
+uint32_t fitMask(const uint32_t *volumes, const uint32_t *weights,
+                 uint32_t vol, uint32_t w);
+
+#endif // DA_PROJ1_FITMASK_H
@@ -0,0 +1,111 @@
+#ifndef DA_PROJ1_FITTREE_H
+#define DA_PROJ1_FITTREE_H
+
+class FitTree;
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "van.hpp"
+
+/**
+ * @brief Tournament tree over the remaining capacity of a list of vans.
+ *
+ * @details The vans are split into blocks of ::FIT_MASK_WIDTH, and every node
+ *          holds the largest remaining volume and the largest remaining weight
+ *          found in its blocks, so whole ranges of vans that can't take an
+ *          order are skipped at once. Inside a block, fitMask() checks every
+ *          van at the same time. Used to find the first van (in the order they
+ *          were given) where an order fits.
+ *
+ *          Both maximums may come from different vans, in which case a subtree
+ *          is visited without finding a van, so a query takes
+ *          \f$ \mathcal{O}(\log v) \f$ when that doesn't happen and at most
+ *          \f$ \mathcal{O}(v) \f$ otherwise, where \f$v\f$ is the number of
+ *          vans.
+ */
+class FitTree {
+    /** @brief How many vans the tree holds. */
+    size_t size;
+    /** @brief How many leaves (blocks) the tree has, always a power of two. */
+    size_t leaves;
+    /** @brief How much volume each van has left, padded with zeros. */
+    std::pmr::vector<uint32_t> volumes;
+    /** @brief How much weight each van has left, padded with zeros. */
+    std::pmr::vector<uint32_t> weights;
+    /** @brief The largest remaining volume in each node's subtree. */
+    std::pmr::vector<uint32_t> volume;
+    /** @brief The largest remaining weight in each node's subtree. */
+    std::pmr::vector<uint32_t> weight;
+
+    /**
+     * @brief Recomputes a leaf from its block of vans.
+     *
+     * @param leaf The index of the leaf node.
+     */
+    void pullBlock(size_t leaf);
+
+    /**
+     * @brief Recomputes a node from its children.
+     *
+     * @param node The index of the node.
+     */
+    void pull(size_t node);
+
+    /**
+     * @brief Finds the first van under a node where an order fits.
+     *
+     * @param node The index of the node.
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t find(size_t node, uint32_t vol, uint32_t w) const;
+
+public:
+    /** @brief Returned by find() when the order doesn't fit any van. */
+    static const size_t npos = -1;
+
+    /**
+     * @brief Creates a tree from the remaining capacity of some vans.
+     *
+     * @param vans The vans, in the order they should be tried.
+     * @param resource Where the memory of the tree comes from.
+     */
+    explicit FitTree(std::span<const Van> vans,
+                     std::pmr::memory_resource *resource =
+                         std::pmr::get_default_resource());
+
+    /**
+     * @brief Finds the first van where an order fits.
+     *
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t find(uint32_t vol, uint32_t w) const;
+
+    /**
+     * @brief Updates the remaining capacity of a van.
+     *
+     * @param i The index of the van.
+     * @param van The van, after being changed.
+     */
+    void update(size_t i, const Van &van);
+
+    /**
+     * @brief Sets the remaining capacity of a van.
+     *
+     * @param i The index of the van.
+     * @param vol How much volume the van has left.
+     * @param w How much weight the van has left.
+     */
+    void update(size_t i, uint32_t vol, uint32_t w);
+};
+
+#endif // DA_PROJ1_FITTREE_H
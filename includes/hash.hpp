@@ -0,0 +1,21 @@
+#ifndef DA_PROJ1_HASH_H
+#define DA_PROJ1_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Hashes some bytes with xxHash64.
+ *
+ * @details Several buffers can be hashed as one by passing the hash of each
+ *          as the seed of the next.
+ *
+ * @param data The bytes.
+ * @param size How many bytes there are.
+ * @param seed The seed of the hash.
+ *
+ * @return The hash.
+ */
+uint64_t xxHash64(const void *data, size_t size, uint64_t seed = 0);
+
+#endif // DA_PROJ1_HASH_H
@@ -0,0 +1,152 @@
+#ifndef DA_PROJ1_INSTRUMENTATION_H
+#define DA_PROJ1_INSTRUMENTATION_H
+
+struct Metrics;
+class MetricsScope;
+class PhaseTimer;
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include "filewriter.hpp"
+#include "utils.hpp"
+
+/**
+ * @brief The phases of a run whose time is measured by a PhaseTimer.
+ */
+ENUM(Phase,
+     /** @brief Loading a dataset from its files. */
+     LOAD,
+     /** @brief Sorting the orders and the vans. */
+     SORT,
+     /** @brief Giving the orders to the vans. */
+     PACK,
+     /** @brief Gathering the orders and totals of a ScenarioResult. */
+     AGGREGATE,
+     /** @brief Improving a packing with a LocalSearch. */
+     IMPROVE);
+
+/**
+ * @brief The events counted with #INSTRUMENT_COUNT.
+ */
+ENUM(Counter,
+     /** @brief Searches for a van where an order fits. */
+     FIT_CHECKS,
+     /** @brief Orders given to a van. */
+     PLACEMENTS,
+     /** @brief Allocations from an Arena. */
+     ALLOCATIONS,
+     /** @brief Orders moved or swapped to another van by a LocalSearch. */
+     MOVES);
+
+/**
+ * @brief How long each Phase took and how many times each Counter happened,
+ *        for a single run or a whole program.
+ *
+ * @details Everything is atomic, so threads helping with a run can add to
+ *          the same metrics, see MetricsScope.
+ */
+struct Metrics {
+    /** @brief How many nanoseconds were spent in each Phase. */
+    std::array<std::atomic<uint64_t>, (size_t)Phase::END> nanoseconds{};
+    /** @brief How many times each Counter happened. */
+    std::array<std::atomic<uint64_t>, (size_t)Counter::END> counts{};
+
+    /**
+     * @return The metrics of the calling thread: the ones given to the
+     *         innermost MetricsScope, or ones shared by the whole program.
+     */
+    static Metrics &current();
+
+    /** @return The name of a phase, as used in csv headers. */
+    static std::string_view name(Phase phase);
+    /** @return The name of a counter, as used in csv headers. */
+    static std::string_view name(Counter counter);
+
+    /**
+     * @brief Writes the names of the columns written by toCSV(), without the
+     *        line break.
+     *
+     * @param out Where to write them.
+     */
+    static void headerCSV(FileWriter &out);
+
+    /**
+     * @brief Writes a csv representation of these metrics, without the line
+     *        break.
+     *
+     * @param out Where to write it.
+     */
+    void toCSV(FileWriter &out) const;
+};
+
+/**
+ * @brief Makes some metrics the ones of the calling thread while it exists.
+ */
+class MetricsScope {
+    /** @brief The metrics of the thread before the scope was created. */
+    Metrics *previous;
+
+public:
+    /**
+     * @brief Makes some metrics the ones of the calling thread.
+     *
+     * @param metrics The metrics, which must outlive the scope.
+     */
+    explicit MetricsScope(Metrics &metrics);
+    MetricsScope(const MetricsScope &) = delete;
+    MetricsScope &operator=(const MetricsScope &) = delete;
+    ~MetricsScope();
+};
+
+/**
+ * @brief Adds the time from its creation to its destruction to a Phase of
+ *        the metrics of the calling thread.
+ */
+class PhaseTimer {
+    /** @brief The phase being timed. */
+    Phase phase;
+    /** @brief When the timer was created. */
+    std::chrono::steady_clock::time_point start;
+
+public:
+    /**
+     * @brief Starts timing a phase.
+     *
+     * @param phase The phase.
+     */
+    explicit PhaseTimer(Phase phase);
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+    ~PhaseTimer();
+};
+
+#ifdef INSTRUMENTATION
+/**
+ * @brief Times the rest of the enclosing scope as a Phase.
+ *
+ * @details Does nothing unless built with INSTRUMENTATION defined.
+ *
+ * @param phase The name of the Phase.
+ */
+#define INSTRUMENT_PHASE(phase) PhaseTimer _phaseTimer{Phase::phase}
+/**
+ * @brief Adds to a Counter of the metrics of the calling thread.
+ *
+ * @details Does nothing unless built with INSTRUMENTATION defined.
+ *
+ * @param counter The name of the Counter.
+ * @param n How much to add.
+ */
+#define INSTRUMENT_COUNT(counter, n)                                           \
+    Metrics::current().counts[(size_t)Counter::counter].fetch_add(             \
+        (n), std::memory_order_relaxed)
+#else
+#define INSTRUMENT_PHASE(phase) ((void)0)
+#define INSTRUMENT_COUNT(counter, n) ((void)0)
+#endif
+
+#endif // DA_PROJ1_INSTRUMENTATION_H
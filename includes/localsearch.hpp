@@ -0,0 +1,184 @@
+#ifndef DA_PROJ1_LOCALSEARCH_H
+#define DA_PROJ1_LOCALSEARCH_H
+
+class LocalSearch;
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "ordertable.hpp"
+#include "random.hpp"
+#include "residualtree.hpp"
+#include "van.hpp"
+
+/**
+ * @brief Improves a packing made by a greedy strategy by moving orders
+ *        between the vans it used.
+ *
+ * @details Vans are visited from the least loaded to the most, and each one
+ *          is emptied by moving its orders to the other vans with the least
+ *          room where they fit, found in a ResidualTree. An order that fits
+ *          nowhere else is swapped with a smaller order of another van, which
+ *          then gets the same treatment. A van whose orders can't all leave
+ *          keeps them, so every step leaves a valid packing. Orders that
+ *          weren't delivered are given to vans with room whenever possible,
+ *          including the ones that were emptied when minimizing vans.
+ *
+ *          To minimize vans, a van only closes once it is empty. To maximize
+ *          profit, it also closes when the orders that couldn't leave are
+ *          worth less than the van costs, and those orders aren't delivered.
+ *
+ *          The remaining capacity and the orders of each van are kept column
+ *          by column, the orders in an intrusive list, so checking whether a
+ *          move or a swap fits takes constant time and making it only needs
+ *          the ResidualTree to be updated. The vans themselves are only
+ *          brought up to date by finish().
+ *
+ * Each move takes an expected
+ * \f$ \mathcal{O}(\log v) \f$
+ * and each attempted swap
+ * \f$ \mathcal{O}(1) \f$,
+ * where \f$v\f$ is the number of vans. The search stops when a whole pass
+ * empties no van, or when its time is up.
+ */
+class LocalSearch {
+    /** @brief Marks the end of a list, or a missing order. */
+    static constexpr uint32_t NIL = -1;
+
+    /** @brief The orders. */
+    const OrderTable &orders;
+    /** @brief The vans that may deliver orders. */
+    std::span<Van> vans;
+    /**
+     * @brief The van delivering each order, or ScenarioResult::UNASSIGNED.
+     */
+    std::span<uint32_t> assignment;
+    /** @brief The order in which undelivered orders are given a van. */
+    std::span<const uint32_t> sequence;
+    /** @brief Whether to maximize profit instead of minimizing vans. */
+    bool profit;
+
+    /** @brief #assignment before the search, to bring the vans up to date. */
+    std::pmr::vector<uint32_t> initial;
+    /** @brief How much volume each van has left. */
+    std::pmr::vector<uint32_t> volumes;
+    /** @brief How much weight each van has left. */
+    std::pmr::vector<uint32_t> weights;
+    /** @brief How many orders each van is delivering. */
+    std::pmr::vector<uint32_t> counts;
+    /** @brief The first order of each van, or #NIL. */
+    std::pmr::vector<uint32_t> heads;
+    /** @brief The order after each order in the list of its van, or #NIL. */
+    std::pmr::vector<uint32_t> next;
+    /** @brief The order before each order in the list of its van, or #NIL. */
+    std::pmr::vector<uint32_t> previous;
+    /**
+     * @brief The size of each order, as the sum of its volume and weight
+     *        relative to the largest capacity of the fleet in each.
+     */
+    std::pmr::vector<double> sizes;
+    /** @brief The remaining capacity of the vans delivering some order. */
+    ResidualTree open;
+    /** @brief The vans the search emptied, which are open no more. */
+    std::pmr::vector<uint32_t> closed;
+    /** @brief Where the orders checked for swaps are drawn from. */
+    SplitMix64 rng{0, 0};
+
+    /**
+     * @brief Gives an order to a van, which must have room for it.
+     *
+     * @param order The index of the order.
+     * @param van The index of the van.
+     */
+    void place(uint32_t order, uint32_t van);
+
+    /**
+     * @brief Takes an order out of its van, leaving it undelivered.
+     *
+     * @param order The index of the order.
+     */
+    void unplace(uint32_t order);
+
+    /**
+     * @brief Tells #open how much capacity a van has left, or takes it out
+     *        if it is empty.
+     *
+     * @param van The index of the van.
+     */
+    void refresh(uint32_t van);
+
+    /**
+     * @brief Moves an order to the van with the least room left where it
+     *        fits, out of the ones in #open.
+     *
+     * @param order The index of the order.
+     *
+     * @return Whether the order was moved.
+     */
+    bool relocate(uint32_t order);
+
+    /**
+     * @brief Swaps an order with a smaller order of another van, checking at
+     *        most ::LOCAL_SEARCH_SWAP_TRIES of them.
+     *
+     * @param order The index of the order.
+     *
+     * @return The order that took its place, or #NIL if there was none.
+     */
+    uint32_t swap(uint32_t order);
+
+    /**
+     * @brief Tries to empty a van.
+     *
+     * @param van The index of the van.
+     *
+     * @return Whether the van was closed.
+     */
+    bool empty(uint32_t van);
+
+    /**
+     * @brief Gives every undelivered order to the van with the least room
+     *        left where it fits, if there is one. When minimizing vans,
+     *        orders that fit in no open van may open one of #closed.
+     */
+    void deliverRemaining();
+
+public:
+    /**
+     * @brief Prepares the search over a packing.
+     *
+     * @param orders The orders.
+     * @param sequence The order in which undelivered orders are given a van.
+     * @param vans The vans that may deliver orders, holding the orders given
+     *             by @p assignment. Vans that are empty are never used.
+     * @param assignment The index of the van in @p vans that is delivering
+     *                   each order in @p orders, or
+     *                   ScenarioResult::UNASSIGNED. Changed by the search.
+     * @param profit Whether to maximize profit instead of minimizing vans.
+     * @param resource Where the memory of the search comes from.
+     */
+    LocalSearch(const OrderTable &orders, std::span<const uint32_t> sequence,
+                std::span<Van> vans, std::span<uint32_t> assignment,
+                bool profit,
+                std::pmr::memory_resource *resource =
+                    std::pmr::get_default_resource());
+
+    /**
+     * @brief Improves the packing until no van can be emptied.
+     *
+     * @param deadline When to stop, even if it could still improve.
+     */
+    void run(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Moves the orders in the vans given to the constructor to where
+     *        the search left them.
+     */
+    void finish();
+};
+
+#endif // DA_PROJ1_LOCALSEARCH_H
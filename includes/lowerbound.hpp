@@ -0,0 +1,31 @@
+#ifndef DA_PROJ1_LOWERBOUND_H
+#define DA_PROJ1_LOWERBOUND_H
+
+#include <cstddef>
+
+#include "dataset.hpp"
+
+/**
+ * @brief Computes a lower bound on how many vans are needed to deliver every
+ *        order that fits in at least one van.
+ *
+ * @details The largest of the Martello–Toth bounds, taken for volume and for
+ *          weight separately:
+ *          - L1: the fewest of the biggest vans whose capacity adds up to the
+ *            size of every order.
+ *          - L2: the bound for identical bins, where every van is as big as
+ *            the biggest one, which can only need fewer vans.
+ *
+ * Overall performance is
+ * \f$ T(o, v) = \mathcal{O}(o \log o + v \log v) \f$ and
+ * \f$ S(o, v) = \mathcal{O}(o + v) \f$,
+ * where \f$o\f$ is the number of orders and \f$v\f$ the number of vans.
+ *
+ * @param dataset The dataset to use.
+ * @param[out] deliverable How many orders fit in at least one van.
+ *
+ * @return The lower bound, never more than the number of vans.
+ */
+size_t vanLowerBound(const Dataset &dataset, size_t &deliverable);
+
+#endif // DA_PROJ1_LOWERBOUND_H
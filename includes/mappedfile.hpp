@@ -0,0 +1,45 @@
+#ifndef DA_PROJ1_MAPPEDFILE_H
+#define DA_PROJ1_MAPPEDFILE_H
+
+class MappedFile;
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read only view over the contents of a file.
+ *
+ * @details The file is mapped into memory, so its contents are only read from
+ *          the disk as they are accessed and are never copied. On systems
+ *          without mmap() the file is read into memory instead.
+ */
+class MappedFile {
+    /** @brief The start of the contents of the file. */
+    const char *data{nullptr};
+    /** @brief How many bytes the file has. */
+    size_t size{0};
+    /** @brief Whether the file was opened successfully. */
+    bool open{false};
+#ifdef _WIN32
+    /** @brief The contents of the file. */
+    std::string buffer{};
+#endif
+
+public:
+    /**
+     * @brief Maps a file into memory.
+     *
+     * @param path The path to the file.
+     */
+    explicit MappedFile(const std::string &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    /** @return Whether the file was opened successfully. */
+    bool isOpen() const;
+    /** @return The contents of the file. */
+    std::string_view getContents() const;
+};
+
+#endif // DA_PROJ1_MAPPEDFILE_H
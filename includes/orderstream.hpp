@@ -0,0 +1,57 @@
+#ifndef DA_PROJ1_ORDERSTREAM_H
+#define DA_PROJ1_ORDERSTREAM_H
+
+#include <istream>
+#include <vector>
+
+#include "scenarios.hpp"
+#include "utils.hpp"
+#include "van.hpp"
+
+/**
+ * @brief Holds the possible strategies for packOrderStream().
+ */
+ENUM(StreamStrategy,
+     /**
+        @brief Give each order to the first van where it fits, with vans by
+               descending "max area" (Van#maxVolume × Van#maxWeight).
+      */
+     FIRST_FIT,
+     /**
+        @brief Give each order to the open van with the least volume left where
+               it fits. Vans are opened by descending "max area".
+      */
+     BEST_FIT);
+
+/**
+ * @brief Packs orders into vans as they are read, without ever holding all of
+ *        them in memory.
+ *
+ * @details Orders can't be sorted before they are packed, so each one is given
+ *          to a van as soon as it arrives, like in scenario1(). Another thread
+ *          reads and parses ::ORDER_STREAM_CHUNK_SIZE bytes at a time and
+ *          hands them over through a BoundedQueue of ::ORDER_STREAM_QUEUE_SIZE
+ *          chunks, so parsing and packing happen at the same time and memory
+ *          doesn't grow with the number of orders.
+ *
+ *          Only the totals are kept, so ScenarioResult#orders is empty and
+ *          only the vans that got some order are in ScenarioResult#vans.
+ *
+ * Overall performance is
+ * \f$ T(o, v) = \mathcal{O}(v + o \log v) \f$ and
+ * \f$ S(o, v) = \mathcal{O}(v) \f$,
+ * where \f$o\f$ is the number of orders and \f$v\f$ the number of vans.
+ *
+ * @throws std::invalid_argument If a line doesn't start with enough values.
+ *
+ * @param in Where to read the orders from, in the same format as
+ *           ::ORDERS_FILE, including the header.
+ * @param vans The vans that can deliver the orders.
+ * @param strat What strategy to implement.
+ *
+ * @return The totals of the result.
+ */
+ScenarioResult packOrderStream(std::istream &in, const std::vector<Van> &vans,
+                               StreamStrategy strat);
+
+#endif // DA_PROJ1_ORDERSTREAM_H
@@ -0,0 +1,243 @@
+#ifndef DA_PROJ1_ORDERTABLE_H
+#define DA_PROJ1_ORDERTABLE_H
+
+class OrderTable;
+class OrderSpan;
+class Order;
+struct DatasetGenerationParams;
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Stores orders column by column.
+ *
+ * @details Each attribute of an Order lives in its own contiguous array, so
+ *          code that only looks at a few attributes of many orders (like
+ *          sorting or packing them) doesn't read the ones it doesn't need.
+ *          Orders are referred to by their index in the table.
+ */
+class OrderTable {
+    /** @brief How much volume each order takes up. */
+    std::vector<uint32_t> volumes;
+    /** @brief How much each order weighs. */
+    std::vector<uint32_t> weights;
+    /** @brief How much reward each order will give. */
+    std::vector<uint32_t> rewards;
+    /** @brief How long each order takes to be delivered. */
+    std::vector<uint32_t> durations;
+    /** @brief Unique number that identifies each order. */
+    std::vector<uint32_t> ids;
+
+public:
+    /** @brief Creates an empty table. */
+    OrderTable() = default;
+
+    /**
+     * @brief Creates a table from a list of orders.
+     *
+     * @param orders The orders to store.
+     */
+    explicit OrderTable(const std::vector<Order> &orders);
+
+    /**
+     * @brief Creates a table from its columns.
+     *
+     * @details The orders get sequential ids, starting at @p firstId.
+     *
+     * @param volumes How much volume each order takes up.
+     * @param weights How much each order weighs.
+     * @param rewards How much reward each order will give.
+     * @param durations How long each order takes to be delivered.
+     * @param firstId The id of the first order.
+     */
+    OrderTable(std::vector<uint32_t> volumes, std::vector<uint32_t> weights,
+               std::vector<uint32_t> rewards, std::vector<uint32_t> durations,
+               uint32_t firstId = 1);
+
+    /**
+     * @brief Creates a table with some of the orders of another table.
+     *
+     * @param table The table to take the orders from.
+     * @param indices The indices of the orders in @p table, in the order they
+     *                should be stored.
+     */
+    OrderTable(const OrderTable &table, std::span<const uint32_t> indices);
+
+    /**
+     * @brief Loads orders from the dataset at a given path.
+     *
+     * @details The file is memory mapped and parsed in place with
+     *          parseColumns(), straight into the columns of the table.
+     *
+     * @note The path must be relative to ::DATASETS_PATH.
+     *
+     * @param path The folder where the dataset is.
+     *
+     * @return A table with the orders that were loaded.
+     */
+    static OrderTable processDataset(const std::string &path);
+
+    /**
+     * @brief Generates orders for a new dataset from pseudo random data and
+     *        stores them in a file.
+     *
+     * @details See generateColumns(). The same parameters always generate the
+     *          same orders.
+     *
+     * @param name The folder where the dataset will be stored.
+     * @param params The parameters given to the random number generators.
+     *
+     * @return A table with the orders that were generated.
+     */
+    static OrderTable generateDataset(const std::string &name,
+                                      const DatasetGenerationParams &params);
+
+    /** @return How many orders are in this table. */
+    size_t size() const;
+    /** @return Whether this table has no orders. */
+    bool empty() const;
+
+    /**
+     * @brief Reserves space for some orders.
+     *
+     * @param n How many orders the table should be able to hold.
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Adds an order to the end of this table.
+     *
+     * @param order The order to add.
+     */
+    void push_back(const Order &order);
+
+    /**
+     * @brief Gets an order from this table.
+     *
+     * @param i The index of the order.
+     *
+     * @return A copy of the order at index @p i.
+     */
+    Order operator[](size_t i) const;
+
+    /**
+     * @brief Gets a view over a range of this table.
+     *
+     * @param begin The index of the first order in the range.
+     * @param count How many orders are in the range.
+     *
+     * @return A view over the range, valid while this table isn't changed.
+     */
+    OrderSpan subspan(size_t begin, size_t count) const;
+
+    /** @return How much volume each order takes up. */
+    const std::vector<uint32_t> &getVolumes() const;
+    /** @return How much each order weighs. */
+    const std::vector<uint32_t> &getWeights() const;
+    /** @return How much reward each order will give. */
+    const std::vector<uint32_t> &getRewards() const;
+    /** @return How long each order takes to be delivered. */
+    const std::vector<uint32_t> &getDurations() const;
+    /** @return Unique number that identifies each order. */
+    const std::vector<uint32_t> &getIds() const;
+
+    // Scenario 1 & 2
+    /**
+     * @brief Sort key that orders indices by ascending volume, then ascending
+     *        weight.
+     */
+    static uint64_t keyByVolumeAsc(const OrderTable &t, size_t i);
+    /**
+     * @brief Sort key that orders indices by descending volume, then
+     *        descending weight.
+     */
+    static uint64_t keyByVolumeDesc(const OrderTable &t, size_t i);
+    /**
+     * @brief Sort key that orders indices by ascending weight, then ascending
+     *        volume.
+     */
+    static uint64_t keyByWeightAsc(const OrderTable &t, size_t i);
+    /**
+     * @brief Sort key that orders indices by descending weight, then
+     *        descending volume.
+     */
+    static uint64_t keyByWeightDesc(const OrderTable &t, size_t i);
+    /**
+     * @brief Sort key that orders indices by ascending "area" (volume ×
+     *        weight).
+     */
+    static uint64_t keyByAreaAsc(const OrderTable &t, size_t i);
+    /**
+     * @brief Sort key that orders indices by descending "area" (volume ×
+     *        weight).
+     */
+    static uint64_t keyByAreaDesc(const OrderTable &t, size_t i);
+
+    // Scenario 3
+    /**
+     * @brief Sort key that orders indices by ascending duration.
+     */
+    static uint64_t keyByDuration(const OrderTable &t, size_t i);
+};
+
+/**
+ * @brief A view over a contiguous range of the orders in an OrderTable.
+ *
+ * @details Doesn't own or copy any orders, so it must not outlive the table it
+ *          was taken from.
+ */
+class OrderSpan {
+    /** @brief How much volume each order takes up. */
+    std::span<const uint32_t> volumes;
+    /** @brief How much each order weighs. */
+    std::span<const uint32_t> weights;
+    /** @brief How much reward each order will give. */
+    std::span<const uint32_t> rewards;
+    /** @brief How long each order takes to be delivered. */
+    std::span<const uint32_t> durations;
+    /** @brief Unique number that identifies each order. */
+    std::span<const uint32_t> ids;
+
+public:
+    /** @brief Creates an empty view. */
+    OrderSpan() = default;
+
+    /**
+     * @brief Creates a view over a range of a table.
+     *
+     * @param table The table.
+     * @param begin The index of the first order in the range.
+     * @param count How many orders are in the range.
+     */
+    OrderSpan(const OrderTable &table, size_t begin, size_t count);
+
+    /** @return How many orders are in this view. */
+    size_t size() const;
+    /** @return Whether this view has no orders. */
+    bool empty() const;
+
+    /**
+     * @brief Gets an order from this view.
+     *
+     * @param i The index of the order, relative to the start of the view.
+     *
+     * @return A copy of the order at index @p i.
+     */
+    Order operator[](size_t i) const;
+
+    /** @return How much volume each order takes up. */
+    std::span<const uint32_t> getVolumes() const;
+    /** @return How much each order weighs. */
+    std::span<const uint32_t> getWeights() const;
+    /** @return How much reward each order will give. */
+    std::span<const uint32_t> getRewards() const;
+    /** @return How long each order takes to be delivered. */
+    std::span<const uint32_t> getDurations() const;
+    /** @return Unique number that identifies each order. */
+    std::span<const uint32_t> getIds() const;
+};
+
+#endif // DA_PROJ1_ORDERTABLE_H
@@ -0,0 +1,230 @@
+#ifndef DA_PROJ1_PACKINGSESSION_H
+#define DA_PROJ1_PACKINGSESSION_H
+
+class PackingSession;
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "dataset.hpp"
+#include "fittree.hpp"
+#include "order.hpp"
+#include "residualtree.hpp"
+#include "scenarios.hpp"
+#include "van.hpp"
+
+/**
+ * @brief Keeps the packing of a scenario1() or scenario2() result up to date
+ *        while orders are added or cancelled, without solving it again.
+ *
+ * @details The vans of the result come first, followed by the vans of the
+ *          dataset it didn't use, and a FitTree over all of them finds the
+ *          first van where a new order fits. When there is none, the order
+ *          tries to take the place of an order that can move to another van,
+ *          looking for a van for at most ::PACKING_SESSION_REPAIR_BUDGET of
+ *          them. Orders bigger than every van, or than the room left in the
+ *          whole fleet, don't try at all.
+ *
+ *          The orders that aren't delivered wait in a ResidualTree, keyed by
+ *          the complement of their size, so the biggest one that fits in the
+ *          capacity freed by a cancellation is found at once.
+ *
+ *          Orders are identified by their id, and their attributes are stored
+ *          column by column in slots that are reused once they are removed.
+ *          The orders of the result keep their ids, and inserted orders are
+ *          given new ones by the session, since the ids of orders created
+ *          elsewhere may be the same as the ones of the dataset.
+ *
+ * Every change takes an expected
+ * \f$ \mathcal{O}((1 + m) \log (o + v) + r v + o) \f$ at worst,
+ * where \f$o\f$ is the number of orders, \f$v\f$ the number of vans, \f$m\f$
+ * how many waiting orders get delivered and \f$r\f$ the repair budget.
+ */
+class PackingSession {
+    /** @brief The vans, with the ones that were used first. */
+    std::vector<Van> vans;
+    /** @brief The remaining capacity of every van. */
+    FitTree fits;
+    /** @brief The volume capacity of every van, descending. */
+    std::vector<uint32_t> capacityVolumes;
+    /**
+     * @brief The largest weight capacity of the vans up to each one of
+     *        #capacityVolumes.
+     */
+    std::vector<uint32_t> capacityWeights;
+    /** @brief How much volume is left in all vans together. */
+    uint64_t freeVolume{0};
+    /** @brief How much weight is left in all vans together. */
+    uint64_t freeWeight{0};
+    /** @brief The orders that aren't delivered, by complemented size. */
+    ResidualTree waiting;
+
+    /** @brief How much volume the order in each slot takes up. */
+    std::vector<uint32_t> volumes;
+    /** @brief How much the order in each slot weighs. */
+    std::vector<uint32_t> weights;
+    /** @brief How much reward the order in each slot will give. */
+    std::vector<uint32_t> rewards;
+    /** @brief How long the order in each slot takes to be delivered. */
+    std::vector<uint32_t> durations;
+    /** @brief The id of the order in each slot. */
+    std::vector<uint32_t> ids;
+    /**
+     * @brief The van delivering the order in each slot, or
+     *        ScenarioResult::UNASSIGNED.
+     */
+    std::vector<uint32_t> assignment;
+    /** @brief Where each slot is in the list of its van. */
+    std::vector<uint32_t> positions;
+    /** @brief The slots of the orders delivered by each van. */
+    std::vector<std::vector<uint32_t>> loads;
+    /** @brief Whether each slot holds an order. */
+    std::vector<bool> used;
+    /** @brief The slot of each order, by id. */
+    std::unordered_map<uint32_t, uint32_t> slots;
+    /** @brief The slots that were freed and can be reused. */
+    std::vector<uint32_t> freeSlots;
+
+    /** @brief The id given to the next order that is inserted. */
+    uint32_t nextId{1};
+    /** @brief The van where the next repair starts looking. */
+    size_t cursor{0};
+    /** @brief How many orders are delivered. */
+    size_t dispatched{0};
+    /** @brief How much time was spent building and changing the packing. */
+    std::chrono::nanoseconds elapsed{0};
+
+    /**
+     * @brief Stores an order in a free slot, not delivered yet.
+     *
+     * @param order The order.
+     *
+     * @return The slot.
+     */
+    uint32_t store(const Order &order);
+
+    /**
+     * @brief Gets the order in a slot.
+     *
+     * @param slot The slot.
+     *
+     * @return A copy of the order.
+     */
+    Order orderAt(uint32_t slot) const;
+
+    /**
+     * @brief Gives an order to a van, which must have room for it.
+     *
+     * @param slot The slot of the order.
+     * @param van The index of the van.
+     */
+    void place(uint32_t slot, uint32_t van);
+
+    /**
+     * @brief Takes an order out of its van, and leaves it waiting.
+     *
+     * @param slot The slot of the order.
+     */
+    void unplace(uint32_t slot);
+
+    /**
+     * @brief Tells #fits how much capacity a van has left.
+     *
+     * @param van The index of the van.
+     */
+    void refresh(uint32_t van);
+
+    /**
+     * @brief Checks whether an order could fit in some van, if it were
+     *        empty, with a binary search over #capacityVolumes.
+     *
+     * @param slot The slot of the order.
+     *
+     * @return Whether it could.
+     */
+    bool fitsFleet(uint32_t slot) const;
+
+    /**
+     * @brief Tries to deliver an order by moving another order to a different
+     *        van to make room for it.
+     *
+     * @param slot The slot of the order.
+     *
+     * @return Whether the order was delivered.
+     */
+    bool repair(uint32_t slot);
+
+    /**
+     * @brief Delivers the biggest waiting orders that fit in a van, until none
+     *        does.
+     *
+     * @param van The index of the van.
+     */
+    void refill(uint32_t van);
+
+public:
+    /**
+     * @brief Starts a session from a result.
+     *
+     * @param dataset The dataset the result was computed from.
+     * @param result The result of scenario1() or scenario2().
+     */
+    PackingSession(const Dataset &dataset, const ScenarioResult &result);
+
+    /**
+     * @brief Adds an order, and tries to deliver it.
+     *
+     * @param order The order. Its id is ignored.
+     *
+     * @return The id the order was given in the session.
+     */
+    uint32_t insert(const Order &order);
+
+    /**
+     * @brief Cancels an order, and uses the capacity it frees to deliver the
+     *        orders that were waiting.
+     *
+     * @param id The id of the order.
+     *
+     * @return Whether the order was in the session.
+     */
+    bool remove(uint32_t id);
+
+    /**
+     * @brief Checks if an order is in the session.
+     *
+     * @param id The id of the order.
+     *
+     * @return Whether it is.
+     */
+    bool contains(uint32_t id) const;
+
+    /**
+     * @brief Checks if an order is being delivered.
+     *
+     * @param id The id of the order.
+     *
+     * @return Whether it is in the session and some van is delivering it.
+     */
+    bool isDelivered(uint32_t id) const;
+
+    /** @return How many orders are in the session. */
+    size_t size() const;
+    /** @return How many orders are being delivered. */
+    size_t getOrdersDispatched() const;
+
+    /**
+     * @brief Builds a result from the current packing.
+     *
+     * @details Only the vans that deliver some order are part of it, and its
+     *          runtime is the time spent in the session so far.
+     *
+     * @return The result.
+     */
+    ScenarioResult toResult() const;
+};
+
+#endif // DA_PROJ1_PACKINGSESSION_H
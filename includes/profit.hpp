@@ -0,0 +1,51 @@
+#ifndef DA_PROJ1_PROFIT_H
+#define DA_PROJ1_PROFIT_H
+
+#include "dataset.hpp"
+#include "scenarios.hpp"
+
+/**
+ * @brief Computes an upper bound on the profit any assignment of orders to
+ *        vans can reach.
+ *
+ * @details Each van can't get more reward than the linear relaxation of a
+ *          knapsack over its volume, nor than the one over its weight, which
+ *          are solved greedily by reward density, so no van adds more than
+ *          that bound minus its cost to the profit.
+ *
+ *          The whole fleet is also bounded, one dimension at a time, by
+ *          letting both orders and vans be split, which keeps every order from
+ *          being counted in more than one van.
+ *
+ * Overall performance is
+ * \f$ T(o, v) = \mathcal{O}(o + (o + v) \log (o + v)) \f$ and
+ * \f$ S(o, v) = \mathcal{O}(o + v) \f$,
+ * where \f$o\f$ is the number of orders and \f$v\f$ the number of vans.
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The upper bound.
+ */
+double profitUpperBound(const Dataset &dataset);
+
+/**
+ * @brief Implementation of Scenario2Strategy::PROFIT.
+ *
+ * @details Vans whose upper bound doesn't pay for their cost are never
+ *          opened. Orders, by descending reward per normalized size, are then
+ *          given to the first van where they fit, with vans by ascending cost
+ *          per normalized capacity. Every van that doesn't make a profit is
+ *          then closed and only its orders are given to the vans left, until
+ *          every van makes one.
+ *
+ *          Finally, starting from the least profitable, each van is emptied
+ *          into the others if the reward lost by the orders that don't fit
+ *          anywhere else is less than its cost.
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+ScenarioResult maximizeProfit(const Dataset &dataset);
+
+#endif // DA_PROJ1_PROFIT_H
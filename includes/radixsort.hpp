@@ -0,0 +1,39 @@
+#ifndef DA_PROJ1_RADIXSORT_H
+#define DA_PROJ1_RADIXSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Sorts a list of indices by ascending keys.
+ *
+ * @details Uses a stable least significant digit radix sort, one byte at a
+ *          time, skipping the bytes that are the same in every key. The
+ *          buffers it needs come from the same memory resources as the lists.
+ *
+ * Overall performance is
+ * \f$ T(n) = \mathcal{O}(n) \f$ and
+ * \f$ S(n) = \mathcal{O}(n) \f$,
+ * where \f$n\f$ is the number of keys.
+ *
+ * @param keys The key of each index, sorted along with @p indices.
+ * @param indices The indices to sort. Must be as long as @p keys.
+ */
+void radixSort(std::pmr::vector<uint64_t> &keys,
+               std::pmr::vector<uint32_t> &indices);
+
+/**
+ * @brief Sort key that orders non-negative doubles by descending value.
+ *
+ * @details The bits of a non-negative double are ordered like the value it
+ *          represents. NaNs are treated as 0.
+ *
+ * @param ratio The value.
+ *
+ * @return The key.
+ */
+uint64_t descendingRatioKey(double ratio);
+
+#endif // DA_PROJ1_RADIXSORT_H
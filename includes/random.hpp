@@ -0,0 +1,58 @@
+#ifndef DA_PROJ1_RANDOM_H
+#define DA_PROJ1_RANDOM_H
+
+class SplitMix64;
+
+#include <cstdint>
+
+/**
+ * @brief Scrambles a number, so nearby numbers give unrelated results.
+ *
+ * @details The finalizer of splitmix64.
+ *
+ * @param x The number.
+ *
+ * @return The scrambled number.
+ */
+uint64_t splitmix64(uint64_t x);
+
+/**
+ * @brief Pseudo random number generator with independent streams.
+ *
+ * @details Each stream is a splitmix64 sequence starting from a state derived
+ *          from both the seed and the number of the stream, so a block of work
+ *          can get its own stream and generate the same numbers no matter
+ *          which thread runs it, or when.
+ */
+class SplitMix64 {
+    /** @brief The state of the generator, advanced by a constant each time. */
+    uint64_t state;
+
+public:
+    /**
+     * @brief Starts a stream.
+     *
+     * @param seed The seed shared by every stream.
+     * @param stream The number of the stream.
+     */
+    SplitMix64(uint64_t seed, uint64_t stream);
+
+    /** @return The next number of the stream. */
+    uint64_t next();
+
+    /**
+     * @brief Draws a number uniformly from a range.
+     *
+     * @details Uses Lemire's multiply and shift, with the few values that would
+     *          make it biased rejected.
+     *
+     * @param min The smallest number that may be drawn.
+     * @param max The largest number that may be drawn. Must not be less than
+     *            @p min.
+     *
+     * @return The number.
+     */
+    uint32_t bounded(uint32_t min, uint32_t max);
+};
+
+#endif // DA_PROJ1_RANDOM_H
@@ -0,0 +1,255 @@
+#ifndef DA_PROJ1_RESIDUALTREE_H
+#define DA_PROJ1_RESIDUALTREE_H
+
+class ResidualTree;
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Balanced search tree over the remaining capacity of a set of vans.
+ *
+ * @details The vans are ordered by remaining volume, then by remaining weight,
+ *          then by index, and every node also holds the largest remaining
+ *          weight in its subtree, so the vans that can't carry an order's
+ *          weight are skipped at once. Balanced as a treap, with priorities
+ *          derived from the index of each van so the shape doesn't depend on
+ *          any random state.
+ *
+ *          mostAligned() and closest() treat the remaining capacity of a van
+ *          as a vector, with each dimension divided by the capacity given to
+ *          normalize(). They are searched by branch and bound: every subtree
+ *          spans a range of remaining volumes and knows the range of its
+ *          remaining weights, which bounds the best score found under it.
+ *
+ * Every operation takes an expected
+ * \f$ \mathcal{O}(\log v) \f$,
+ * where \f$v\f$ is the number of vans in the tree, except for mostAligned()
+ * and closest(), which may take up to
+ * \f$ \mathcal{O}(v) \f$
+ * when the bounds don't rule out many subtrees.
+ */
+class ResidualTree {
+    /** @brief Marks a missing node. */
+    static constexpr uint32_t NIL = -1;
+
+    /** @brief The root of the tree. */
+    uint32_t root{NIL};
+    /** @brief The left child of each van. */
+    std::pmr::vector<uint32_t> left;
+    /** @brief The right child of each van. */
+    std::pmr::vector<uint32_t> right;
+    /** @brief The heap priority of each van. */
+    std::pmr::vector<uint64_t> priorities;
+    /** @brief How much volume each van has left. */
+    std::pmr::vector<uint32_t> volumes;
+    /** @brief How much weight each van has left. */
+    std::pmr::vector<uint32_t> weights;
+    /** @brief The largest remaining weight in each van's subtree. */
+    std::pmr::vector<uint32_t> maxWeights;
+    /** @brief The smallest remaining weight in each van's subtree. */
+    std::pmr::vector<uint32_t> minWeights;
+    /** @brief Whether each van is in the tree. */
+    std::pmr::vector<bool> present;
+    /** @brief What a unit of volume is worth once normalized. */
+    double volumeScale{1};
+    /** @brief What a unit of weight is worth once normalized. */
+    double weightScale{1};
+
+    /**
+     * @brief Checks if a van comes before a key in the tree.
+     *
+     * @param i The index of the van.
+     * @param vol The remaining volume of the key.
+     * @param w The remaining weight of the key.
+     * @param j The index of the key.
+     *
+     * @return Whether the van comes first.
+     */
+    bool less(uint32_t i, uint32_t vol, uint32_t w, uint32_t j) const;
+
+    /**
+     * @brief Recomputes the range of remaining weights under a node.
+     *
+     * @param node The node.
+     */
+    void pull(uint32_t node);
+
+    /**
+     * @brief Splits a subtree into the vans before a van and the rest.
+     *
+     * @param node The root of the subtree.
+     * @param i The van to split at, whose key is its current capacity.
+     * @param[out] l The vans that come before @p i.
+     * @param[out] r The other vans.
+     */
+    void split(uint32_t node, uint32_t i, uint32_t &l, uint32_t &r);
+
+    /**
+     * @brief Joins two subtrees, where every van in @p l comes first.
+     *
+     * @param l The first subtree.
+     * @param r The second subtree.
+     *
+     * @return The root of the joined tree.
+     */
+    uint32_t merge(uint32_t l, uint32_t r);
+
+    /**
+     * @brief Removes a van from a subtree.
+     *
+     * @param node The root of the subtree.
+     * @param i The van.
+     *
+     * @return The new root of the subtree.
+     */
+    uint32_t erase(uint32_t node, uint32_t i);
+
+    /**
+     * @brief Finds the first van under a node where an order fits.
+     *
+     * @param node The root of the subtree.
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t lowest(uint32_t node, uint32_t vol, uint32_t w) const;
+
+    /**
+     * @brief Finds the last van under a node that can carry a weight.
+     *
+     * @param node The root of the subtree.
+     * @param w The weight.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t highest(uint32_t node, uint32_t w) const;
+
+    /**
+     * @brief Searches a subtree for the van where an order fits whose
+     *        remaining capacity has the largest dot product with the order.
+     *
+     * @param node The root of the subtree.
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     * @param hi The most volume any van in the subtree has left.
+     * @param[in,out] best The best score found so far.
+     * @param[in,out] found The van with the best score, or #npos.
+     */
+    void aligned(uint32_t node, uint32_t vol, uint32_t w, uint32_t hi,
+                 double &best, size_t &found) const;
+
+    /**
+     * @brief Searches a subtree for the van where an order fits whose
+     *        remaining capacity is closest to the order.
+     *
+     * @param node The root of the subtree.
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     * @param lo The least volume any van in the subtree has left.
+     * @param[in,out] best The smallest squared distance found so far.
+     * @param[in,out] found The van at that distance, or #npos.
+     */
+    void nearest(uint32_t node, uint32_t vol, uint32_t w, uint32_t lo,
+                 double &best, size_t &found) const;
+
+public:
+    /** @brief Returned by the searches when an order doesn't fit any van. */
+    static constexpr size_t npos = -1;
+
+    /**
+     * @brief Creates an empty tree.
+     *
+     * @param size How many vans may be inserted, indexed from 0.
+     * @param resource Where the memory of the tree comes from.
+     */
+    explicit ResidualTree(size_t size, std::pmr::memory_resource *resource =
+                                           std::pmr::get_default_resource());
+
+    /**
+     * @brief Makes room for more vans, which start out of the tree.
+     *
+     * @param size How many vans may be inserted, indexed from 0. Must not be
+     *             less than before.
+     */
+    void resize(size_t size);
+
+    /**
+     * @brief Sets the capacity that is worth 1 in each dimension, for
+     *        mostAligned() and closest(), so both dimensions weigh the same
+     *        no matter their units.
+     *
+     * @param volume The volume worth 1.
+     * @param weight The weight worth 1.
+     */
+    void normalize(uint32_t volume, uint32_t weight);
+
+    /**
+     * @brief Inserts a van, or updates its remaining capacity.
+     *
+     * @param i The index of the van.
+     * @param vol How much volume the van has left.
+     * @param w How much weight the van has left.
+     */
+    void update(size_t i, uint32_t vol, uint32_t w);
+
+    /**
+     * @brief Removes a van from the tree, if it is there.
+     *
+     * @param i The index of the van.
+     */
+    void remove(size_t i);
+
+    /**
+     * @brief Finds the van with the least volume left where an order fits,
+     *        breaking ties by the least weight left.
+     *
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t bestFit(uint32_t vol, uint32_t w) const;
+
+    /**
+     * @brief Finds the van with the most volume left where an order fits,
+     *        breaking ties by the most weight left.
+     *
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t worstFit(uint32_t vol, uint32_t w) const;
+
+    /**
+     * @brief Finds the van where an order fits whose normalized remaining
+     *        capacity has the largest dot product with the normalized order,
+     *        which is the van with the most room in the dimensions the order
+     *        needs the most.
+     *
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t mostAligned(uint32_t vol, uint32_t w) const;
+
+    /**
+     * @brief Finds the van where an order fits whose normalized remaining
+     *        capacity is closest to the normalized order, by L2 norm, which is
+     *        the van the order leaves with the least room, in both dimensions
+     *        at once.
+     *
+     * @param vol The volume of the order.
+     * @param w The weight of the order.
+     *
+     * @return The index of the van, or #npos if there is none.
+     */
+    size_t closest(uint32_t vol, uint32_t w) const;
+};
+
+#endif // DA_PROJ1_RESIDUALTREE_H
@@ -0,0 +1,133 @@
+#ifndef DA_PROJ1_RESULTCACHE_H
+#define DA_PROJ1_RESULTCACHE_H
+
+class ResultCache;
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "dataset.hpp"
+#include "scenarios.hpp"
+
+/**
+ * @brief Keeps the results of scenario runs, so running the same strategy on
+ *        a dataset with the same contents again doesn't solve it again.
+ *
+ * @details Results are keyed by Dataset::getHash(), the scenario and the
+ *          strategy. The last ::RESULT_CACHE_MAX_ENTRIES are kept in memory
+ *          and, with ::RESULT_CACHE_ON_DISK, every one is also written to
+ *          ::RESULT_CACHE_PATH, one file each, so they outlive the program.
+ *
+ *          On disk, only the totals of a result and the indices of its
+ *          orders and vans in the dataset are kept. The orders and vans
+ *          themselves are taken from the dataset when the result is read.
+ *
+ *          Every method can be called from several threads at once.
+ */
+class ResultCache {
+    /** @brief What identifies a result. */
+    struct Key {
+        /** @brief The hash of the dataset. */
+        uint64_t dataset;
+        /** @brief The number of the scenario. */
+        int scenario;
+        /** @brief The value of the strategy. */
+        int strategy;
+
+        bool operator==(const Key &) const = default;
+    };
+
+    /** @brief Hashes a Key for #results. */
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    /** @brief The results kept in memory. */
+    std::unordered_map<Key, ScenarioResult, KeyHash> results;
+    /** @brief The keys of #results, from the oldest to the newest. */
+    std::deque<Key> age;
+    /** @brief Guards #results and #age. */
+    std::mutex mutex;
+
+    /**
+     * @param key The key of a result.
+     *
+     * @return The path of the file of the result.
+     */
+    static std::string path(const Key &key);
+
+    /**
+     * @brief Reads a result from disk.
+     *
+     * @param key The key of the result.
+     * @param dataset The dataset the result is about.
+     *
+     * @return The result, or nothing if there is no valid file for it.
+     */
+    static std::optional<ScenarioResult> read(const Key &key,
+                                              const Dataset &dataset);
+
+    /**
+     * @brief Writes a result to disk.
+     *
+     * @details Results that aren't ScenarioResult#persistent, or with orders
+     *          or vans that aren't in the dataset, aren't written. Vans must
+     *          have the same id, capacities and cost as the ones of the
+     *          dataset.
+     *
+     * @param key The key of the result.
+     * @param dataset The dataset the result is about.
+     * @param result The result.
+     */
+    static void write(const Key &key, const Dataset &dataset,
+                      const ScenarioResult &result);
+
+    /**
+     * @brief Keeps a result in memory, forgetting the oldest if there are
+     *        too many.
+     *
+     * @param key The key of the result.
+     * @param result The result.
+     */
+    void remember(const Key &key, const ScenarioResult &result);
+
+public:
+    /** @return The cache shared by the whole program. */
+    static ResultCache &global();
+
+    /**
+     * @brief Gets the result of running a strategy on a dataset.
+     *
+     * @param dataset The dataset.
+     * @param scenario The number of the scenario.
+     * @param strategy The value of the strategy.
+     *
+     * @return The result, or nothing if it isn't cached.
+     */
+    std::optional<ScenarioResult> get(const Dataset &dataset, int scenario,
+                                      int strategy);
+
+    /**
+     * @brief Caches the result of running a strategy on a dataset.
+     *
+     * @param dataset The dataset.
+     * @param scenario The number of the scenario.
+     * @param strategy The value of the strategy.
+     * @param result The result.
+     */
+    void put(const Dataset &dataset, int scenario, int strategy,
+             const ScenarioResult &result);
+
+    /**
+     * @brief Forgets every result of a dataset, in memory and on disk.
+     *
+     * @param dataset The hash of the dataset, see Dataset::getHash().
+     */
+    void invalidate(uint64_t dataset);
+};
+
+#endif // DA_PROJ1_RESULTCACHE_H
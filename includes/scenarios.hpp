@@ -2,12 +2,16 @@
 #define DA_PROJ1_SCENARIOS_HPP
 
 #include <chrono>
-#include <functional>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "dataset.hpp"
+#include "filewriter.hpp"
 #include "order.hpp"
+#include "ordertable.hpp"
 #include "utils.hpp"
 #include "van.hpp"
 
@@ -15,12 +19,31 @@
  * @brief Represents the results of a scenario.
  */
 struct ScenarioResult {
-    /** @brief The orders that were not delivered. */
-    std::vector<Order> remainingOrders{};
+    /** @brief Marks an order that wasn't assigned to any van. */
+    static constexpr uint32_t UNASSIGNED = -1;
+
+    /**
+     * @brief The orders, grouped by the van delivering them, followed by the
+     *        orders that were not delivered.
+     */
+    OrderTable orders{};
+    /**
+     * @brief Where the orders of each van start in #orders.
+     *
+     * @details Has one more element than #vans, where the orders that were not
+     *          delivered start.
+     */
+    std::vector<size_t> offsets{0};
     /** @brief The vans that were used. */
     std::vector<Van> vans{};
     /** @brief How many orders that were delivered. */
     int ordersDispatched{0};
+    /**
+     * @brief How many orders were not delivered.
+     *
+     * @details Also known when #orders isn't kept, as in packOrderStream().
+     */
+    int ordersRemaining{0};
     /** @brief How much time the orders took to be delivered. */
     double deliveryTime{0};
     /**
@@ -36,36 +59,105 @@ struct ScenarioResult {
     int reward{0};
     /** @brief Total profit (#reward - #cost). */
     int profit{0};
-    /** @brief How much time the algorithm took to run. */
+    /**
+     * @brief How much time the algorithm took to run, or finding the result
+     *        if it was #cached.
+     */
     std::chrono::microseconds runtime{0};
+    /**
+     * @brief The best value the objective of the scenario could have, if it
+     *        is known. For scenario1() it's a lower bound on how many #vans
+     *        are needed, and for scenario2() an upper bound on #profit.
+     */
+    std::optional<double> bound{};
+    /**
+     * @brief How far the result is from #bound, relative to the bigger of the
+     *        two, if it is known. 0 means the result is optimal.
+     */
+    std::optional<double> gap{};
+    /**
+     * @brief Whether every van of the result is a van of the dataset, so a
+     *        ResultCache can keep it on disk. Scenario 3 uses a van that isn't.
+     */
+    bool persistent{true};
+    /** @brief Whether the result was taken from a ResultCache. */
+    bool cached{false};
+
+    /** @brief Creates an empty scenario result. */
+    ScenarioResult() = default;
 
     /**
      * @brief Creates a scenario result from the given params.
      *
-     * @param remainingOrders The orders that were not delivered.
+     * @details Groups the orders by van with a counting sort, whose buffers
+     *          come from the Arena of the calling thread.
+     *
+     * @param orders The orders that were given to the algorithm.
+     * @param sequence The indices of the orders in @p orders, in the order
+     *                 they should be listed.
+     * @param assignment The index of the van in @p vans that is delivering
+     *                   each order in @p orders, or #UNASSIGNED.
      * @param vans The vans that were used.
      * @param runtime How much time the algorithm took to run.
      */
-    ScenarioResult(const std::vector<Order> &remainingOrders,
-                   const std::vector<Van> &vans,
+    ScenarioResult(const OrderTable &orders,
+                   std::span<const uint32_t> sequence,
+                   std::span<const uint32_t> assignment,
+                   std::vector<Van> vans,
                    const std::chrono::microseconds &runtime);
 
     /**
-     * @brief Converts this object to a csv representation.
+     * @brief Gets the orders delivered by a van.
+     *
+     * @param van The index of the van in #vans.
      *
-     * @return A csv representation of this object.
+     * @return A view over the orders, valid while this result exists.
      */
-    std::string toCSV() const;
+    OrderSpan getOrders(size_t van) const;
+
+    /**
+     * @return A view over the orders that were not delivered, valid while
+     *         this result exists.
+     */
+    OrderSpan getRemainingOrders() const;
+
+    /**
+     * @brief Writes a csv representation of this object, without the line
+     *        break.
+     *
+     * @param out Where to write it.
+     */
+    void toCSV(FileWriter &out) const;
 };
 
 /**
- * @brief Function to be used in std::sort() to sort orders.
+ * @brief Options of a run of scenario1() or scenario2(), for the strategies
+ *        that stop when their time is up.
  */
-using OrderOrdering = std::function<bool(const Order &, const Order &)>;
+struct ScenarioOptions {
+    /**
+     * @brief How long the strategy may keep improving its result, or nothing
+     *        for its default, ::MULTI_START_TIME_BUDGET or
+     *        ::LOCAL_SEARCH_TIME_BUDGET.
+     */
+    std::optional<std::chrono::milliseconds> timeBudget{};
+    /**
+     * @brief How many threads the strategy may use, 0 to use
+     *        getThreadCount().
+     */
+    unsigned int threads{0};
+};
+
+/**
+ * @brief Function that computes the key used to sort the order at an index of
+ *        an OrderTable. Orders are sorted by ascending key.
+ */
+using OrderKey = uint64_t (*)(const OrderTable &, size_t);
 /**
- * @brief Function to be used in std::sort() to sort vans.
+ * @brief Function that computes the key used to sort a van. Vans are sorted by
+ *        ascending key.
  */
-using VanOrdering = std::function<bool(const Van &, const Van &)>;
+using VanKey = uint64_t (*)(const Van &);
 
 /**
  * @brief Holds the possible strategies for scenario1().
@@ -101,25 +193,75 @@ ENUM(
        @brief Sort orders by descending "area" (Order#volume × Order#weight)
               and vans by descending "max area" (Van#maxVolume × Van#maxWeight).
      */
-    AREA_DESC);
+    AREA_DESC,
+    /**
+       @brief Sort orders by descending "area" (Order#volume × Order#weight)
+              and give each to the open van with the least volume left where
+              it fits. Vans are opened by descending "max area".
+     */
+    BEST_FIT,
+    /**
+       @brief Sort orders by descending "area" (Order#volume × Order#weight)
+              and give each to the open van with the most volume left where
+              it fits. Vans are opened by descending "max area".
+     */
+    WORST_FIT,
+    /**
+       @brief Run Scenario1Strategy::AREA_DESC, then more runs in parallel
+              with the orders and vans shuffled a little each time, keeping
+              the result with the fewest vans. Stops making new runs after
+              ScenarioOptions#timeBudget.
+     */
+    MULTI_START,
+    /**
+       @brief Sort orders by descending "area" (Order#volume × Order#weight)
+              and give each to the open van whose remaining capacity, as a
+              (volume, weight) vector, has the largest dot product with the
+              order. Vans are opened by descending "max area".
+     */
+    DOT_PRODUCT,
+    /**
+       @brief Sort orders by descending "area" (Order#volume × Order#weight)
+              and give each to the open van whose remaining capacity, as a
+              (volume, weight) vector, is closest to the order by L2 norm.
+              Vans are opened by descending "max area".
+     */
+    L2_NORM,
+    /**
+       @brief Run Scenario1Strategy::AREA_DESC, then move and swap orders
+              between the vans to empty the least loaded ones, with a
+              LocalSearch. Stops after ScenarioOptions#timeBudget.
+     */
+    LOCAL_SEARCH);
 
 /**
  * @brief Tries to maximize the amount of orders delivered and to minimize the
  *        amount of vans used.
  *
- * Uses an implementation of First Fit Decreasing Bin-Packing.
+ * Uses an implementation of First Fit Decreasing Bin-Packing, backed by a
+ * FitTree, with the orders and vans sorted by radixSort(). Best Fit, Worst
+ * Fit and the vector packing strategies (Scenario1Strategy::DOT_PRODUCT and
+ * Scenario1Strategy::L2_NORM) keep the open vans in a ResidualTree instead,
+ * the latter with both dimensions normalized by the largest capacity of the
+ * fleet. Scenario1Strategy::MULTI_START keeps the best of many First Fit runs
+ * and Scenario1Strategy::LOCAL_SEARCH improves one with a LocalSearch.
+ *
+ * When every order that fits in a van is delivered, the result is compared
+ * with vanLowerBound() in ScenarioResult#gap.
  *
  * Overall performance is
- * \f$ T(o, v) = \mathcal{O}(o \log o + v \log v + o \cdot v) \f$ and
+ * \f$ T(o, v) = \mathcal{O}(o + v + o \log v) \f$ and
  * \f$ S(o, v) = \mathcal{O}(o + v) \f$,
  * where \f$o\f$ is the number of orders and \f$v\f$ the number of vans.
  *
  * @param dataset The dataset to use.
  * @param strat What strategy to implement.
+ * @param options The budget of the strategy, if it has one.
  *
  * @return The result of the algorithm.
  */
-const ScenarioResult scenario1(const Dataset &dataset, Scenario1Strategy strat);
+const ScenarioResult scenario1(const Dataset &dataset, Scenario1Strategy strat,
+                               const ScenarioOptions &options = {});
 
 /**
  * @brief Holds the possible strategies for scenario2().
@@ -156,46 +298,128 @@ ENUM(Scenario2Strategy,
                and vans by descending "max area" (Van#maxVolume × Van#maxWeight)
                divided by Van#cost.
       */
-     AREA_DESC);
+     AREA_DESC,
+     /**
+        @brief Weigh Order#reward against Van#cost, only opening the vans
+               that make a profit. See maximizeProfit().
+      */
+     PROFIT,
+     /**
+        @brief Run Scenario2Strategy::AREA_DESC, then more runs in parallel
+               with the orders and vans shuffled a little each time, keeping
+               the result with the most profit. Stops making new runs after
+               ScenarioOptions#timeBudget.
+      */
+     MULTI_START,
+     /**
+        @brief Run Scenario2Strategy::AREA_DESC, then move and swap orders
+               between the vans to empty the least loaded ones, closing the
+               vans that cost more than the orders they can't get rid of,
+               with a LocalSearch. Stops after ScenarioOptions#timeBudget.
+      */
+     LOCAL_SEARCH);
 
 /**
  * @brief Tries to maximize the amount of orders delivered and the overall
  *        profit.
  *
- * Uses an implementation of First Fit Decreasing Bin-Packing.
+ * Uses an implementation of First Fit Decreasing Bin-Packing, backed by a
+ * FitTree, with the orders and vans sorted by radixSort(), except for
+ * Scenario2Strategy::PROFIT, which uses maximizeProfit(),
+ * Scenario2Strategy::MULTI_START, which keeps the best of many of them, and
+ * Scenario2Strategy::LOCAL_SEARCH, which improves one with a LocalSearch.
+ *
+ * Every result is compared with profitUpperBound() in ScenarioResult#gap.
  *
  * Overall performance is
- * \f$ T(o, v) = \mathcal{O}(o \log o + v \log v + o \cdot v) \f$ and
+ * \f$ T(o, v) = \mathcal{O}(o + v + o \log v) \f$ and
  * \f$ S(o, v) = \mathcal{O}(o + v) \f$,
  * where \f$o\f$ is the number of orders and \f$v\f$ the number of vans.
  *
  * @param dataset The dataset to use.
  * @param strat What strategy to implement.
+ * @param options The budget of the strategy, if it has one.
  *
  * @return The result of the algorithm.
  */
-const ScenarioResult scenario2(const Dataset &dataset, Scenario2Strategy strat);
+const ScenarioResult scenario2(const Dataset &dataset, Scenario2Strategy strat,
+                               const ScenarioOptions &options = {});
+
+/**
+ * @brief Holds the possible strategies for scenario3().
+ */
+ENUM(Scenario3Strategy,
+     /**
+        @brief Deliver the quickest orders first, which also minimizes the
+               average delivery time.
+      */
+     QUICKEST_FIRST,
+     /**
+        @brief Of the sets with the most orders that can be delivered, deliver
+               the one with the highest total Order#reward.
+      */
+     MAX_REWARD);
 
 /**
  * @brief Tries to maximize the amount of orders delivered by a single van in a
- *        work day and to minimize the average delivery time.
+ *        work day and, depending on the strategy, to minimize the average
+ *        delivery time or to maximize the reward.
  *
- * Uses a greedy algorithm that selects the quickest orders first.
+ * Scenario3Strategy::QUICKEST_FIRST uses a greedy algorithm that selects the
+ * quickest orders first, with
+ * \f$ T(o) = \mathcal{O}(o) \f$ and
+ * \f$ S(o) = \mathcal{O}(o) \f$.
  *
- * Overall performance is
- * \f$ T(o) = \mathcal{O}(o \log o) \f$ and
- * \f$ S(o) = \mathcal{O}(o) \f$,
- * where \f$o\f$ is the number of orders.
+ * Scenario3Strategy::MAX_REWARD uses an exact 0/1 knapsack over the seconds of
+ * the work day, with
+ * \f$ T(o, c) = \mathcal{O}(o \log o + c t) \f$ and
+ * \f$ S(o, c) = \mathcal{O}(o + \min(c t / 64, m)) \f$,
+ * where \f$c\f$ is the number of orders that could be part of the best set
+ * and \f$m\f$ is ::SCENARIO3_MAX_TABLE_SIZE.
+ *
+ * In both, \f$o\f$ is the number of orders and \f$t\f$ is
+ * ::WORK_DAY_DURATION.
  *
  * @param dataset The dataset to use.
+ * @param strat What strategy to implement.
  *
  * @return The result of the algorithm.
  */
-const ScenarioResult scenario3(const Dataset &dataset);
+const ScenarioResult scenario3(const Dataset &dataset, Scenario3Strategy strat);
+
+/**
+ * @brief Runs a strategy of a scenario, unless its result is in the
+ *        ResultCache, and caches the result.
+ *
+ * @details Strategies whose result depends on how much time they are given,
+ *          or how many threads, are never cached. A result taken from the
+ *          cache is ScenarioResult#cached, and its runtime is how long it
+ *          took to find it.
+ *
+ * @param dataset The dataset to use.
+ * @param scenario The number of the scenario, from 1 to 3.
+ * @param strategy The value of the strategy.
+ * @param useCache Whether to use the ResultCache at all. Without it, the
+ *                 strategy always runs and its result isn't cached.
+ * @param options The budget of the strategy, if it has one.
+ *
+ * @return The result of the strategy.
+ */
+ScenarioResult runScenario(const Dataset &dataset, int scenario, int strategy,
+                           bool useCache = true,
+                           const ScenarioOptions &options = {});
 
 /**
  * @brief Runs every scenario for every dataset with all possible strategies and
  *        outputs the results to ::OUTPUT_FILE.
+ *
+ * @details The runs are spread across every core with parallelFor(), but the
+ *          results are written in the same order as if they ran one by one.
+ *          Like any scenario, each run takes its memory from the Arena of the
+ *          thread it runs on, which is reset once it ends. The ResultCache
+ *          isn't used, so every runtime is measured, and each run uses a
+ *          single thread, so runs never start threads of their own on top of
+ *          the ones already running.
  */
 void runAllScenarios();
 
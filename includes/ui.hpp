@@ -27,6 +27,10 @@ enum class Menu {
     CHOOSE_DATASET,
     /** @brief Allows the user to generate a new dataset. */
     GENERATE_DATASET,
+    /** @brief Allows the user to convert a dataset to the binary format. */
+    CONVERT_DATASET,
+    /** @brief Packs orders from a file as they are read. */
+    STREAM_ORDERS,
 
     /** @brief Runs scenario 1. */
     SCENARIO_ONE,
@@ -41,6 +45,8 @@ enum class Menu {
     RESULTS,
     /** @brief Shows info about the vans used in a scenario result. */
     RESULTS_VANS,
+    /** @brief Shows the orders of a scenario result and their vans. */
+    RESULTS_ORDERS,
 
     /** @brief Exits the program. */
     EXIT
@@ -68,9 +74,10 @@ class UserInterface {
     std::string errorMessage{};
 
     /**
-     * @brief The result that is shown in resultsMenu() and resultsVansMenu().
+     * @brief The result that is shown in resultsMenu(), resultsVansMenu()
+     *        and resultsOrdersMenu().
      */
-    ScenarioResult result{{}, {}, {}};
+    ScenarioResult result{};
 
     /**
      * @brief Helper method to show a menu with options.
@@ -166,13 +173,19 @@ class UserInterface {
     /**
      * @brief Helper method to show a list a small amount of items at a time.
      *
-     * @details Shows ::ITEMS_PER_PAGE items per page.
+     * @details Shows ::ITEMS_PER_PAGE items per page. Only the items of the
+     *          page being shown are formatted, so lists can be views that
+     *          make each item when it is asked for. Typing an id goes to the
+     *          page of the item with that id, found with an IdIndex built
+     *          the first time the list is searched.
      *
-     * @tparam T The type of item to show. Must be printable.
+     * @tparam T The type of list to show. Must have a size() method, an
+     *           operator[] that returns printable items and a _getIds()
+     *           overload in ui.cpp.
      *
      * @param items The list of items to show.
      */
-    template <class T> void paginatedMenu(const std::vector<T> &items);
+    template <class T> void paginatedMenu(const T &items);
 
     /**
      * @brief Displays an initial menu to start the program.
@@ -212,6 +225,18 @@ class UserInterface {
      */
     void generateDatasetMenu(Dataset &dataset);
 
+    /**
+     * @brief Allows the user to convert a dataset to the binary format.
+     */
+    void convertDatasetMenu();
+
+    /**
+     * @brief Packs orders from a file as they are read.
+     *
+     * @param dataset The dataset holding the vans.
+     */
+    void streamOrdersMenu(Dataset &dataset);
+
     /**
      * @brief Runs scenario 1.
      *
@@ -248,6 +273,11 @@ class UserInterface {
      */
     void resultsVansMenu();
 
+    /**
+     * @brief Shows the orders of a scenario result, grouped by van.
+     */
+    void resultsOrdersMenu();
+
 public:
     /**
      * @brief Shows the current menu.
@@ -40,7 +40,18 @@
          name != type::END;                                                    \
          name = static_cast<type>(static_cast<int>(name) + 1))
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 /**
@@ -58,6 +69,51 @@ class Exit {};
  */
 std::vector<std::string> split(std::string str, char sep);
 
+/**
+ * @brief Parses a dataset file where every line holds a few unsigned integers
+ *        separated by spaces.
+ *
+ * @details The first line is a header and is ignored, unless @p header is
+ *          false, as are empty lines and any values past the number of
+ *          columns. Values are parsed in place, and the columns are resized
+ *          once up front from the number of lines.
+ *
+ * @throws std::invalid_argument If a line doesn't start with enough values.
+ *
+ * @param text The contents of the file.
+ * @param columns Where the values of each column are appended.
+ * @param header Whether @p text starts with the header.
+ */
+void parseColumns(std::string_view text,
+                  std::initializer_list<std::vector<uint32_t> *> columns,
+                  bool header = true);
+
+/**
+ * @brief Generates a dataset file where every line holds a few unsigned
+ *        integers separated by spaces, drawn uniformly from a range each.
+ *
+ * @details The rows are split into blocks of ::GENERATOR_BLOCK_SIZE, and each
+ *          block draws its numbers from its own SplitMix64 stream, so blocks
+ *          are generated and formatted in parallel with parallelFor() and the
+ *          result only depends on the seed. The text of each block is written
+ *          to the file with a single call.
+ *
+ * @param path The path of the file.
+ * @param header The first line of the file, including the newline.
+ * @param rows How many lines to generate, besides the header.
+ * @param seed The seed of the generator.
+ * @param ranges The smallest and largest value of each column.
+ * @param columns Where the values of each column are stored, replacing what
+ *                they had.
+ *
+ * @return Whether the file was written.
+ */
+bool generateColumns(
+    const std::string &path, std::string_view header, size_t rows,
+    uint64_t seed,
+    std::initializer_list<std::pair<uint32_t, uint32_t>> ranges,
+    std::initializer_list<std::vector<uint32_t> *> columns);
+
 /**
  * @brief Normalizes a string.
  *
@@ -68,4 +124,141 @@ std::vector<std::string> split(std::string str, char sep);
  */
 void normalizeInput(std::string &input);
 
+/**
+ * @brief Sets how many threads parallelFor() uses by default.
+ *
+ * @param threads How many threads, 0 to use one per core.
+ */
+void setThreadCount(unsigned int threads);
+
+/** @return How many threads parallelFor() uses by default. */
+unsigned int getThreadCount();
+
+/**
+ * @brief Calls a function for every index in [0, \p n), spread across
+ *        several threads.
+ *
+ * @details Each thread takes the next index that hasn't been taken yet, so
+ *          slow calls don't hold back the other threads. The calls may happen
+ *          in any order.
+ *
+ * @param n How many indices there are.
+ * @param f The function to call with each index.
+ * @param threads How many threads to use, 0 to use getThreadCount().
+ */
+template <class F> void parallelFor(size_t n, F &&f, unsigned int threads = 0) {
+    if (threads == 0)
+        threads = getThreadCount();
+    threads = std::min<size_t>(threads, n);
+
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i; (i = next++) < n;)
+            f(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; ++t)
+        pool.emplace_back(work);
+
+    work();
+
+    for (std::thread &t : pool)
+        t.join();
+}
+
+/**
+ * @brief Queue that passes items from one thread to another, holding at most a
+ *        few at a time.
+ *
+ * @details The producer waits while the queue is full, so it can't get ahead
+ *          of the consumer by more than the capacity of the queue. A consumer
+ *          that stops early cancels the queue, so the producer never waits
+ *          for room that won't come.
+ *
+ * @tparam T The type of the items.
+ */
+template <class T> class BoundedQueue {
+    /** @brief The items that weren't taken yet. */
+    std::deque<T> items;
+    /** @brief How many items the queue can hold. */
+    size_t capacity;
+    /** @brief Whether no more items will be pushed. */
+    bool closed{false};
+    /** @brief Guards every other member. */
+    std::mutex mutex;
+    /** @brief Signaled when an item is pushed or the queue is closed. */
+    std::condition_variable notEmpty;
+    /** @brief Signaled when an item is popped or the queue is closed. */
+    std::condition_variable notFull;
+
+public:
+    /**
+     * @brief Creates an empty queue.
+     *
+     * @param capacity How many items the queue can hold.
+     */
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    /**
+     * @brief Adds an item to the back of the queue, waiting for room first.
+     *
+     * @param item The item.
+     *
+     * @return Whether the item was added, which it isn't once the queue is
+     *         closed.
+     */
+    bool push(T item) {
+        std::unique_lock lock{mutex};
+        notFull.wait(lock, [&] { return items.size() < capacity || closed; });
+
+        if (closed)
+            return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Takes the item at the front of the queue, waiting for one first.
+     *
+     * @return The item.
+     * @return Nothing if the queue is closed and empty.
+     */
+    std::optional<T> pop() {
+        std::unique_lock lock{mutex};
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+
+        if (items.empty())
+            return {};
+
+        T item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+
+        return item;
+    }
+
+    /** @brief Marks that no more items will be pushed. */
+    void close() {
+        std::lock_guard lock{mutex};
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    /**
+     * @brief Closes the queue and throws away the items that weren't taken,
+     *        for when the consumer stops early.
+     */
+    void cancel() {
+        std::lock_guard lock{mutex};
+        closed = true;
+        items.clear();
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+};
+
 #endif
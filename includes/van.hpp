@@ -6,6 +6,8 @@ class Van;
 #include "dataset.hpp"
 #include "order.hpp"
 
+#include <cstdint>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -13,8 +15,12 @@ class Van;
  * @brief Represents a van that can deliver orders.
  */
 class Van {
-    /** @brief Used to generate sequential ids. */
-    static unsigned int GLOBAL_ID;
+    /**
+     * @brief Used to generate sequential ids.
+     *
+     * @note Atomic because scenarios running in parallel may create vans.
+     */
+    static std::atomic<unsigned int> GLOBAL_ID;
 
     /** @brief How much volume this van can handle. */
     unsigned int maxVolume;
@@ -28,8 +34,8 @@ class Van {
     unsigned int currentWeight;
     /** @brief Unique number that identifies this van. */
     unsigned int id;
-    /** @brief The orders this van is delivering. */
-    std::vector<Order> orders;
+    /** @brief How many orders this van is delivering. */
+    unsigned int orderCount;
 
 public:
     /**
@@ -51,23 +57,30 @@ public:
     unsigned int getCurrentVolume() const;
     /** @return How much weight this van is carrying. */
     unsigned int getCurrentWeight() const;
-    /** @return The orders this van is delivering. */
-    std::vector<Order> getOrders() const;
+    /** @return How many orders this van is delivering. */
+    unsigned int getOrderCount() const;
+    /** @return Unique number that identifies this van. */
+    unsigned int getId() const;
 
     /**
-     * @brief Creates a van from a set of tokens.
+     * @brief Creates vans from the columns of a dataset.
      *
-     * @param tokens The parameters to create the order from. Must be three
-     *               strings representing the #maxVolume, #maxWeight and #cost
-     *               for the van.
+     * @param maxVolumes How much volume each van can handle.
+     * @param maxWeights How much weight each van can handle.
+     * @param costs How much each van costs to operate.
      *
-     * @return The van that was created.
+     * @return A vector of vans, with sequential ids starting at 1.
      */
-    static Van from(const std::vector<std::string> &tokens);
+    static std::vector<Van> fromColumns(const std::vector<uint32_t> &maxVolumes,
+                                        const std::vector<uint32_t> &maxWeights,
+                                        const std::vector<uint32_t> &costs);
 
     /**
      * @brief Loads vans from the dataset at a given path.
      *
+     * @details The file is memory mapped and parsed in place with
+     *          parseColumns().
+     *
      * @note The path must be relative to ::DATASETS_PATH.
      *
      * @param path The folder where the dataset is.
@@ -99,6 +112,13 @@ public:
      */
     bool addOrder(const Order &order);
 
+    /**
+     * @brief Removes an order that was added to this van.
+     *
+     * @param order The order to be removed.
+     */
+    void removeOrder(const Order &order);
+
     /**
      * @brief Checks if an order can fit in this van.
      *
@@ -120,37 +140,37 @@ public:
 
     // Scenario 1
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        #maxVolume.
+     * @brief Sort key that orders vans by descending #maxVolume, then
+     *        descending #maxWeight.
      */
-    static bool compareByVolume(const Van &v1, const Van &v2);
+    static uint64_t keyByVolume(const Van &v);
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        #maxWeight.
+     * @brief Sort key that orders vans by descending #maxWeight, then
+     *        descending #maxVolume.
      */
-    static bool compareByWeight(const Van &v1, const Van &v2);
+    static uint64_t keyByWeight(const Van &v);
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        "max area" (#maxVolume × #maxWeight).
+     * @brief Sort key that orders vans by descending "max area" (#maxVolume ×
+     *        #maxWeight).
      */
-    static bool compareByArea(const Van &v1, const Van &v2);
+    static uint64_t keyByArea(const Van &v);
 
     // Scenario 2
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        #maxVolume divided by #cost.
+     * @brief Sort key that orders vans by descending #maxVolume divided by
+     *        #cost.
      */
-    static bool compareByVolumeOverCost(const Van &v1, const Van &v2);
+    static uint64_t keyByVolumeOverCost(const Van &v);
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        #maxWeight divided by #cost.
+     * @brief Sort key that orders vans by descending #maxWeight divided by
+     *        #cost.
      */
-    static bool compareByWeightOverCost(const Van &v1, const Van &v2);
+    static uint64_t keyByWeightOverCost(const Van &v);
     /**
-     * @brief Function to be used in std::sort() to sort vans by descending
-     *        "max area" (#maxVolume × #maxWeight) divided by #cost.
+     * @brief Sort key that orders vans by descending "max area" (#maxVolume ×
+     *        #maxWeight) divided by #cost.
      */
-    static bool compareByAreaOverCost(const Van &v1, const Van &v2);
+    static uint64_t keyByAreaOverCost(const Van &v);
 };
 
 #endif
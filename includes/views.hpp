@@ -0,0 +1,127 @@
+#ifndef DA_PROJ1_VIEWS_H
+#define DA_PROJ1_VIEWS_H
+
+class IdIndex;
+struct ResultOrderRow;
+class ResultOrdersView;
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "order.hpp"
+#include "scenarios.hpp"
+
+/**
+ * @brief Finds the position of an item of a list by its id, to jump to the
+ *        page where it is shown.
+ *
+ * @details Lists whose ids are ascending, like the ones of a dataset that
+ *          was just loaded, are searched directly, without copying anything.
+ *          Otherwise the ids are sorted once, when the index is created, so
+ *          each search only takes
+ *          \f$ \mathcal{O}(\log n) \f$.
+ */
+class IdIndex {
+    /**
+     * @brief The ids of the list, sorted, if they weren't already. Empty
+     *        otherwise.
+     */
+    std::pmr::vector<uint64_t> sorted;
+    /** @brief The position in the list of each id of #sorted. */
+    std::pmr::vector<uint32_t> positions;
+
+public:
+    /**
+     * @brief Creates the index of a list.
+     *
+     * Overall performance is
+     * \f$ T(n) = \mathcal{O}(n) \f$ and
+     * \f$ S(n) = \mathcal{O}(n) \f$,
+     * where \f$n\f$ is the number of items, or
+     * \f$ S(n) = \mathcal{O}(1) \f$
+     * if the ids are ascending.
+     *
+     * @param ids The id of each item of the list.
+     */
+    explicit IdIndex(std::span<const uint32_t> ids);
+
+    /**
+     * @brief Finds an item by its id.
+     *
+     * @param ids The id of each item of the list, the same ones the index
+     *            was created with.
+     * @param id The id to look for.
+     *
+     * @return The position of the item, or nothing if there is none with
+     *         that id.
+     */
+    std::optional<size_t> find(std::span<const uint32_t> ids,
+                               uint32_t id) const;
+};
+
+/**
+ * @brief An order of a ScenarioResult and the van delivering it, as shown by
+ *        ResultOrdersView.
+ */
+struct ResultOrderRow {
+    /** @brief The id of the van delivering the order, if it was delivered. */
+    std::optional<unsigned int> van;
+    /** @brief The order. */
+    Order order;
+
+    /**
+     * @brief Prints the van id, or '-', followed by the order.
+     *
+     * @param out The stream to print to.
+     * @param row The row to print.
+     *
+     * @return @p out
+     */
+    friend std::ostream &operator<<(std::ostream &out,
+                                    const ResultOrderRow &row);
+};
+
+/**
+ * @brief Lists the orders of a ScenarioResult, grouped by the van delivering
+ *        them and followed by the ones that weren't delivered.
+ *
+ * @details Nothing is copied: each row is made from ScenarioResult#orders
+ *          and ScenarioResult#offsets only when it is asked for, so showing a
+ *          page costs the same no matter how big the result is.
+ */
+class ResultOrdersView {
+    /** @brief The result being shown. */
+    const ScenarioResult *result;
+
+public:
+    /**
+     * @brief Creates a view over the orders of a result.
+     *
+     * @param result The result, which must outlive the view.
+     */
+    explicit ResultOrdersView(const ScenarioResult &result);
+
+    /** @return How many orders the result has. */
+    size_t size() const;
+
+    /**
+     * @brief Gets a row of this view.
+     *
+     * @details Finds the van with a binary search over
+     *          ScenarioResult#offsets.
+     *
+     * @param i The index of the order in ScenarioResult#orders.
+     *
+     * @return The order at index @p i and its van.
+     */
+    ResultOrderRow operator[](size_t i) const;
+
+    /** @return The id of each order, in the order of the rows. */
+    std::span<const uint32_t> getIds() const;
+};
+
+#endif // DA_PROJ1_VIEWS_H
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <memory>
+#include <new>
+
+#include "../includes/arena.hpp"
+#include "../includes/constants.hpp"
+#include "../includes/instrumentation.hpp"
+
+Arena::~Arena() {
+    for (Block &block : blocks)
+        ::operator delete(block.data);
+}
+
+void Arena::grow(size_t size) {
+    // Doubling the capacity keeps the number of blocks low
+    size = std::max({size, capacity(), ARENA_MIN_BLOCK_SIZE});
+
+    blocks.push_back({static_cast<std::byte *>(::operator new(size)), size});
+    next = blocks.back().data;
+    end = next + size;
+}
+
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    INSTRUMENT_COUNT(ALLOCATIONS, 1);
+
+    void *p = next;
+    size_t space = end - next;
+
+    if (next == nullptr || !std::align(alignment, bytes, p, space)) {
+        grow(bytes + alignment);
+
+        p = next;
+        space = end - next;
+        std::align(alignment, bytes, p, space);
+    }
+
+    next = static_cast<std::byte *>(p) + bytes;
+    return p;
+}
+
+void Arena::do_deallocate(void *, size_t, size_t) {}
+
+bool Arena::do_is_equal(const memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+Arena &Arena::local() {
+    thread_local Arena arena;
+    return arena;
+}
+
+void Arena::reset() {
+    if (blocks.size() > 1) {
+        size_t size = capacity();
+
+        for (Block &block : blocks)
+            ::operator delete(block.data);
+        blocks.clear();
+
+        grow(size);
+    }
+
+    if (!blocks.empty()) {
+        next = blocks.front().data;
+        end = next + blocks.front().size;
+    }
+}
+
+Arena::Mark Arena::mark() const { return {blocks.size(), next}; }
+
+void Arena::release(const Mark &mark) {
+    if (mark.blocks == 0 || mark.next == blocks.front().data) {
+        reset();
+        return;
+    }
+
+    for (size_t i = mark.blocks; i < blocks.size(); ++i)
+        ::operator delete(blocks[i].data);
+    blocks.resize(mark.blocks);
+
+    next = mark.next;
+    end = blocks.back().data + blocks.back().size;
+}
+
+size_t Arena::capacity() const {
+    size_t size = 0;
+
+    for (const Block &block : blocks)
+        size += block.size;
+
+    return size;
+}
+
+ArenaScope::ArenaScope() : mark(Arena::local().mark()) {}
+
+ArenaScope::~ArenaScope() { Arena::local().release(mark); }
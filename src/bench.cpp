@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string_view>
+
+#include "../includes/constants.hpp"
+#include "../includes/dataset.hpp"
+#include "../includes/packingsession.hpp"
+#include "../includes/random.hpp"
+#include "../includes/scenarios.hpp"
+
+std::string DATASETS_PATH;
+
+/** @brief How many times operator new was called since the program started. */
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+/**
+ * @brief Options that can be given to the benchmark on the command line.
+ */
+struct BenchParams {
+    /** @brief The number of orders of the smallest dataset. */
+    size_t minOrders{1000};
+    /** @brief The number of orders of the biggest dataset. */
+    size_t maxOrders{10000000};
+    /** @brief How many runs of each scenario are not measured. */
+    size_t warmups{2};
+    /** @brief How many runs of each scenario are measured. */
+    size_t runs{10};
+    /** @brief How many orders each run of a PackingSession changes. */
+    size_t deltas{1000};
+};
+
+/**
+ * @brief Runs a scenario a few times and prints a csv line with its stats.
+ *
+ * @param params The benchmark options.
+ * @param dataset The dataset the scenario runs on.
+ * @param scenario The number of the scenario, for the output.
+ * @param strategy The number of the strategy, for the output.
+ * @param run Runs the scenario once.
+ * @param items How many items each run handles, for the throughput. The
+ *              orders of the dataset by default.
+ */
+template <class F>
+static void measure(const BenchParams &params, const Dataset &dataset,
+                    int scenario, int strategy, F run, size_t items = 0) {
+    for (size_t i = 0; i < params.warmups; ++i)
+        run();
+
+    std::vector<double> times(params.runs);
+    size_t allocationsBefore = allocations.load(std::memory_order_relaxed);
+
+    for (double &time : times) {
+        auto tstart = std::chrono::steady_clock::now();
+        run();
+        auto tend = std::chrono::steady_clock::now();
+
+        time = std::chrono::duration<double, std::micro>(tend - tstart).count();
+    }
+
+    size_t allocationsAfter = allocations.load(std::memory_order_relaxed);
+
+    std::sort(times.begin(), times.end());
+
+    size_t n = times.size();
+    double median = n % 2 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+    // Nearest rank
+    double p99 = times[(size_t)std::ceil(0.99 * n) - 1];
+    size_t orders = dataset.getOrders().size();
+
+    if (items == 0)
+        items = orders;
+
+    std::cout << orders << ',' << dataset.getVans().size() << ',' << scenario
+              << ',' << strategy << ',' << n << ',' << median << ',' << p99
+              << ',' << items / (median / 1e6) << ','
+              << (allocationsAfter - allocationsBefore) / n << std::endl;
+}
+
+/**
+ * @brief Measures a PackingSession started from the first fit decreasing
+ *        packing of a dataset, as scenario 0.
+ *
+ * @details Each run cancels a random order or inserts a copy of a random
+ *          order of the dataset, as many times as BenchParams#deltas, so the
+ *          number of orders stays about the same. Only the changes are
+ *          measured. Once every run is done, the session must still agree
+ *          with the result built from it, and its vans must be within their
+ *          capacity.
+ *
+ * @param params The benchmark options.
+ * @param dataset The dataset.
+ *
+ * @return Whether the session stayed consistent.
+ */
+static bool measureSession(const BenchParams &params, const Dataset &dataset) {
+    const OrderTable &orders = dataset.getOrders();
+
+    if (orders.size() == 0)
+        return true;
+
+    PackingSession session{dataset,
+                           scenario1(dataset, Scenario1Strategy::AREA_DESC)};
+    std::vector<uint32_t> ids(orders.getIds().begin(), orders.getIds().end());
+    SplitMix64 rng{0, 0};
+    bool consistent = true;
+
+    measure(
+        params, dataset, 0, 0,
+        [&] {
+            for (size_t i = 0; i < params.deltas; ++i) {
+                if (!ids.empty() && rng.bounded(0, 1) == 0) {
+                    size_t k = rng.bounded(0, ids.size() - 1);
+
+                    consistent &= session.remove(ids[k]);
+                    ids[k] = ids.back();
+                    ids.pop_back();
+                } else {
+                    Order order = orders[rng.bounded(0, orders.size() - 1)];
+                    ids.push_back(session.insert(order));
+                }
+            }
+        },
+        params.deltas);
+
+    // Checked once every run is done, so it isn't measured
+    ScenarioResult result = session.toResult();
+
+    consistent &= session.size() == ids.size() &&
+                  result.orders.size() == ids.size() &&
+                  (size_t)result.ordersDispatched ==
+                      session.getOrdersDispatched();
+
+    for (size_t v = 0; v < result.vans.size(); ++v) {
+        const Van &van = result.vans[v];
+        OrderSpan load = result.getOrders(v);
+        uint64_t volume = 0, weight = 0;
+
+        for (size_t k = 0; k < load.size(); ++k) {
+            volume += load[k].getVolume();
+            weight += load[k].getWeight();
+        }
+
+        consistent &= volume == van.getCurrentVolume() &&
+                      weight == van.getCurrentWeight() &&
+                      volume <= van.getMaxVolume() &&
+                      weight <= van.getMaxWeight();
+    }
+
+    return consistent;
+}
+
+/**
+ * @brief Parses the command line options.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ *
+ * @return The options, or nothing if they are invalid.
+ */
+static std::optional<BenchParams> parseArguments(int argc, char **argv) {
+    BenchParams params{};
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view option = argv[i];
+        size_t value = std::strtoull(argv[i + 1], nullptr, 10);
+
+        if (option == "--min-orders")
+            params.minOrders = value;
+        else if (option == "--max-orders")
+            params.maxOrders = value;
+        else if (option == "--warmups")
+            params.warmups = value;
+        else if (option == "--runs")
+            params.runs = value;
+        else if (option == "--deltas")
+            params.deltas = value;
+        else
+            return {};
+    }
+
+    if (argc % 2 == 0 || params.minOrders == 0 || params.runs == 0 ||
+        params.deltas == 0)
+        return {};
+
+    return params;
+}
+
+int main(int argc, char **argv) {
+    std::optional<BenchParams> params = parseArguments(argc, argv);
+
+    if (!params) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--min-orders N] [--max-orders N] [--warmups N]"
+                     " [--runs N] [--deltas N]\n";
+        return 1;
+    }
+
+    // The generated datasets are kept apart from the real ones
+    DATASETS_PATH = std::filesystem::weakly_canonical(argv[0])
+                        .parent_path()
+                        .append("bench_datasets/")
+                        .string();
+    std::filesystem::create_directories(DATASETS_PATH);
+
+    std::cout << BENCH_HEADER;
+
+    for (size_t orders = params->minOrders; orders <= params->maxOrders;
+         orders *= 10) {
+        std::cerr << "Generating " << orders << " orders" << std::endl;
+
+        // About half of the orders fit in the vans
+        DatasetGenerationParams generationParams{};
+        generationParams.numberOfOrders = orders;
+        generationParams.numberOfVans = std::max<size_t>(orders / 20, 1);
+
+        Dataset dataset =
+            Dataset::generate(std::to_string(orders), generationParams);
+
+        FOR_ENUM(Scenario1Strategy, strat) {
+            measure(*params, dataset, 1, (int)strat,
+                    [&] { scenario1(dataset, strat); });
+        }
+        FOR_ENUM(Scenario2Strategy, strat) {
+            measure(*params, dataset, 2, (int)strat,
+                    [&] { scenario2(dataset, strat); });
+        }
+        FOR_ENUM(Scenario3Strategy, strat) {
+            measure(*params, dataset, 3, (int)strat,
+                    [&] { scenario3(dataset, strat); });
+        }
+
+        if (!measureSession(*params, dataset)) {
+            std::cerr << "PackingSession is inconsistent on " << orders
+                      << " orders" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <string_view>
+
+#include "../includes/cli.hpp"
+#include "../includes/constants.hpp"
+#include "../includes/dataset.hpp"
+#include "../includes/filewriter.hpp"
+#include "../includes/scenarios.hpp"
+
+/**
+ * @brief The name of each Scenario1Strategy, indexed by its value.
+ */
+constexpr std::string_view SCENARIO1_STRATEGY_NAMES[] = {
+    "", // BEGIN
+    "VOLUME_ASC", "VOLUME_DESC", "WEIGHT_ASC", "WEIGHT_DESC",
+    "AREA_ASC",   "AREA_DESC",   "BEST_FIT",   "WORST_FIT",
+    "MULTI_START", "DOT_PRODUCT", "L2_NORM", "LOCAL_SEARCH",
+};
+static_assert(std::size(SCENARIO1_STRATEGY_NAMES) ==
+              (size_t)Scenario1Strategy::END);
+
+/**
+ * @brief The name of each Scenario2Strategy, indexed by its value.
+ */
+constexpr std::string_view SCENARIO2_STRATEGY_NAMES[] = {
+    "", // BEGIN
+    "VOLUME_ASC", "VOLUME_DESC", "WEIGHT_ASC", "WEIGHT_DESC",
+    "AREA_ASC",   "AREA_DESC",   "PROFIT",     "MULTI_START",
+    "LOCAL_SEARCH",
+};
+static_assert(std::size(SCENARIO2_STRATEGY_NAMES) ==
+              (size_t)Scenario2Strategy::END);
+
+/**
+ * @brief The name of each Scenario3Strategy, indexed by its value.
+ */
+constexpr std::string_view SCENARIO3_STRATEGY_NAMES[] = {
+    "", // BEGIN
+    "QUICKEST_FIRST",
+    "MAX_REWARD",
+};
+static_assert(std::size(SCENARIO3_STRATEGY_NAMES) ==
+              (size_t)Scenario3Strategy::END);
+
+/**
+ * @brief Finds a strategy by its name.
+ *
+ * @param name The name of the strategy.
+ * @param names The name of each strategy, indexed by its value.
+ *
+ * @return The value of the strategy, or 0 if there is none with that name.
+ */
+static int _findStrategy(std::string_view name,
+                         std::span<const std::string_view> names) {
+    for (size_t i = 1; i < names.size(); ++i)
+        if (names[i] == name)
+            return i;
+
+    return 0;
+}
+
+/**
+ * @brief Parses a whole argument as a number.
+ *
+ * @param value The argument.
+ * @param[out] number Where to store the number.
+ *
+ * @return Whether the argument is only a number, in decimal and without a
+ *         sign unless @p number is signed, that fits in @p number.
+ */
+template <class T>
+static bool _parseNumber(std::string_view value, T &number) {
+    const char *end = value.data() + value.size();
+    auto [p, ec] = std::from_chars(value.data(), end, number);
+
+    return ec == std::errc{} && p == end;
+}
+
+std::optional<SolveParams> parseSolveArguments(int argc, char **argv) {
+    SolveParams params{};
+    std::string_view strategy = "";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string_view option = argv[i];
+        std::string_view value = argv[i + 1];
+        unsigned int number;
+
+        if (option == "--dataset")
+            params.dataset = value;
+        else if (option == "--scenario") {
+            if (!_parseNumber(value, params.scenario))
+                return {};
+        } else if (option == "--strategy")
+            strategy = value;
+        else if (option == "--threads") {
+            // Leaving the option out is how to use one thread per core
+            if (!_parseNumber(value, params.threads) || params.threads == 0)
+                return {};
+        } else if (option == "--budget") {
+            if (!_parseNumber(value, number))
+                return {};
+
+            params.budget = std::chrono::milliseconds{number};
+        } else if (option == "--out")
+            params.out = value;
+        else if (option == "--cache" && value == "on")
+            params.cache = true;
+        else if (option == "--cache" && value == "off")
+            params.cache = false;
+        else
+            return {};
+    }
+
+    if (argc % 2 == 0 || params.dataset.empty() ||
+        params.dataset.find('/') != std::string::npos)
+        return {};
+
+    switch (params.scenario) {
+    case 1:
+        params.strategy = _findStrategy(strategy, SCENARIO1_STRATEGY_NAMES);
+        break;
+    case 2:
+        params.strategy = _findStrategy(strategy, SCENARIO2_STRATEGY_NAMES);
+        break;
+    case 3:
+        params.strategy = _findStrategy(strategy, SCENARIO3_STRATEGY_NAMES);
+        break;
+    default:
+        return {};
+    }
+
+    if (params.strategy == 0)
+        return {};
+
+    return params;
+}
+
+int solve(const char *program, int argc, char **argv) {
+    std::optional<SolveParams> params = parseSolveArguments(argc, argv);
+
+    if (!params) {
+        std::cerr << "Usage: " << program << ' ' << argv[0]
+                  << " --dataset NAME --scenario 1|2|3 --strategy NAME"
+                     " [--threads N] [--budget MS] [--out FILE]"
+                     " [--cache on|off]\n";
+        return 1;
+    }
+
+    if (!std::filesystem::is_directory(DATASETS_PATH + params->dataset)) {
+        std::cerr << "Dataset not found: " << params->dataset << '\n';
+        return 1;
+    }
+
+    setThreadCount(params->threads);
+
+    Dataset dataset = Dataset::load(params->dataset);
+
+    ScenarioOptions options{};
+    options.timeBudget = params->budget;
+
+    ScenarioResult result = runScenario(dataset, params->scenario,
+                                        params->strategy, params->cache,
+                                        options);
+
+    FileWriter row{};
+    row << OUTPUT_HEADER << params->dataset << ',' << params->scenario << ','
+        << params->strategy << ',';
+    result.toCSV(row);
+    row << '\n';
+
+    if (params->out.empty()) {
+        std::cout << row.getContents() << std::flush;
+        return 0;
+    }
+
+    FileWriter out{params->out};
+    out << row.getContents();
+    out.flush();
+
+    if (!out.good()) {
+        std::cerr << "Couldn't write to " << params->out << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,29 +1,298 @@
 #include <algorithm>
+#include <bit>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 
 #include "../includes/constants.hpp"
 #include "../includes/dataset.hpp"
+#include "../includes/hash.hpp"
+#include "../includes/instrumentation.hpp"
+#include "../includes/mappedfile.hpp"
 #include "../includes/order.hpp"
+#include "../includes/resultcache.hpp"
 #include "../includes/van.hpp"
 
-Dataset::Dataset(const std::vector<Order> &orders, const std::vector<Van> &vans)
-    : orders(orders), vans(vans) {}
+/** @brief Size in bytes of the header of a binary dataset file. */
+static const size_t BINARY_HEADER_SIZE =
+    BINARY_MAGIC.size() + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+/**
+ * @brief Reads a little endian integer.
+ *
+ * @param p Where the integer is.
+ *
+ * @return The integer.
+ */
+template <class T> static T readLittleEndian(const char *p) {
+    T value = 0;
+
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value |= (T)(unsigned char)p[i] << (8 * i);
+
+    return value;
+}
+
+/**
+ * @brief Writes a little endian integer.
+ *
+ * @param out The stream to write to.
+ * @param value The integer.
+ */
+template <class T> static void writeLittleEndian(std::ostream &out, T value) {
+    char bytes[sizeof(T)];
+
+    for (size_t i = 0; i < sizeof(T); ++i)
+        bytes[i] = (char)(value >> (8 * i));
+
+    out.write(bytes, sizeof(T));
+}
+
+/**
+ * @brief Reads a column of little endian integers from a binary dataset.
+ *
+ * @param p Where the column starts, moved to where it ends.
+ * @param n How many integers the column has.
+ *
+ * @return The column.
+ */
+static std::vector<uint32_t> readColumn(const char *&p, size_t n) {
+    std::vector<uint32_t> column(n);
+
+    if (n == 0)
+        return column;
+
+    if constexpr (std::endian::native == std::endian::little)
+        std::memcpy(column.data(), p, n * sizeof(uint32_t));
+    else
+        for (size_t i = 0; i < n; ++i)
+            column[i] = readLittleEndian<uint32_t>(p + i * sizeof(uint32_t));
+
+    p += n * sizeof(uint32_t);
+    return column;
+}
+
+/**
+ * @brief Writes a column of little endian integers to a binary dataset.
+ *
+ * @param out The stream to write to.
+ * @param column The column.
+ */
+static void writeColumn(std::ostream &out,
+                        const std::vector<uint32_t> &column) {
+    if constexpr (std::endian::native == std::endian::little)
+        out.write((const char *)column.data(),
+                  column.size() * sizeof(uint32_t));
+    else
+        for (uint32_t value : column)
+            writeLittleEndian(out, value);
+}
+
+/**
+ * @brief Hashes the contents of a dataset, one column at a time.
+ *
+ * @param orders The orders of the dataset.
+ * @param vans The vans of the dataset.
+ *
+ * @return The hash.
+ */
+static uint64_t _hashContents(const OrderTable &orders,
+                              const std::vector<Van> &vans) {
+    uint64_t sizes[] = {orders.size(), vans.size()};
+    uint64_t hash = xxHash64(sizes, sizeof(sizes));
+
+    auto hashColumn = [&](const std::vector<uint32_t> &column) {
+        hash = xxHash64(column.data(), column.size() * sizeof(uint32_t), hash);
+    };
+
+    hashColumn(orders.getVolumes());
+    hashColumn(orders.getWeights());
+    hashColumn(orders.getRewards());
+    hashColumn(orders.getDurations());
+
+    std::vector<uint32_t> vanColumns;
+    vanColumns.reserve(3 * vans.size());
+
+    for (const Van &v : vans) {
+        vanColumns.push_back(v.getMaxVolume());
+        vanColumns.push_back(v.getMaxWeight());
+        vanColumns.push_back(v.getCost());
+    }
+
+    hashColumn(vanColumns);
+    return hash;
+}
+
+/**
+ * @brief Keeps the hash of a dataset in its folder.
+ *
+ * @param path The folder where the dataset is.
+ * @param hash The hash of the dataset.
+ */
+static void _keepHash(const std::string &path, uint64_t hash) {
+    std::ofstream out{DATASETS_PATH + path + HASH_FILE, std::ios::binary};
+    writeLittleEndian(out, hash);
+}
+
+/**
+ * @brief Reads the hash kept in the folder of a dataset.
+ *
+ * @param path The folder where the dataset is.
+ *
+ * @return The hash, or nothing if none was kept.
+ */
+static std::optional<uint64_t> _keptHash(const std::string &path) {
+    std::ifstream in{DATASETS_PATH + path + HASH_FILE, std::ios::binary};
+    char bytes[sizeof(uint64_t)];
+
+    if (!in.read(bytes, sizeof(bytes)))
+        return {};
+
+    return readLittleEndian<uint64_t>(bytes);
+}
+
+Dataset::Dataset(OrderTable orders, std::vector<Van> vans)
+    : vans(std::move(vans)), orders(std::move(orders)),
+      hash(_hashContents(this->orders, this->vans)) {}
 
 const std::vector<Van> &Dataset::getVans() const { return vans; }
-const std::vector<Order> &Dataset::getOrders() const { return orders; }
+const OrderTable &Dataset::getOrders() const { return orders; }
+uint64_t Dataset::getHash() const { return hash; }
+
+Dataset Dataset::loadText(const std::string &path) {
+    return {OrderTable::processDataset(path), Van::processDataset(path)};
+}
+
+std::optional<Dataset> Dataset::loadBinary(const std::string &path) {
+    MappedFile file{DATASETS_PATH + path + BINARY_FILE};
+
+    if (!file.isOpen())
+        return {};
+
+    std::string_view contents = file.getContents();
+
+    if (contents.size() < BINARY_HEADER_SIZE ||
+        contents.substr(0, BINARY_MAGIC.size()) != BINARY_MAGIC)
+        return {};
+
+    const char *p = contents.data() + BINARY_MAGIC.size();
+
+    uint32_t version = readLittleEndian<uint32_t>(p);
+    uint64_t orderCount = readLittleEndian<uint64_t>(p + sizeof(uint32_t));
+    uint64_t vanCount =
+        readLittleEndian<uint64_t>(p + sizeof(uint32_t) + sizeof(uint64_t));
+    p = contents.data() + BINARY_HEADER_SIZE;
+
+    // The counts are checked first so the size can't overflow
+    if (version != BINARY_VERSION || orderCount > contents.size() ||
+        vanCount > contents.size() ||
+        contents.size() !=
+            BINARY_HEADER_SIZE +
+                (4 * orderCount + 3 * vanCount) * sizeof(uint32_t))
+        return {};
+
+    std::vector<uint32_t> volumes = readColumn(p, orderCount);
+    std::vector<uint32_t> weights = readColumn(p, orderCount);
+    std::vector<uint32_t> rewards = readColumn(p, orderCount);
+    std::vector<uint32_t> durations = readColumn(p, orderCount);
+
+    std::vector<uint32_t> maxVolumes = readColumn(p, vanCount);
+    std::vector<uint32_t> maxWeights = readColumn(p, vanCount);
+    std::vector<uint32_t> costs = readColumn(p, vanCount);
+
+    return Dataset{
+        {std::move(volumes), std::move(weights), std::move(rewards),
+         std::move(durations)},
+        Van::fromColumns(maxVolumes, maxWeights, costs),
+    };
+}
+
+bool Dataset::isBinaryUpToDate(const std::string &path) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+
+    auto binaryTime =
+        fs::last_write_time(DATASETS_PATH + path + BINARY_FILE, error);
+
+    if (error)
+        return false;
+
+    for (const std::string &file : {ORDERS_FILE, VANS_FILE}) {
+        auto textTime = fs::last_write_time(DATASETS_PATH + path + file, error);
+
+        // A missing text file can't be newer
+        if (!error && textTime > binaryTime)
+            return false;
+    }
+
+    return true;
+}
 
 Dataset Dataset::load(const std::string &path) {
-    return {Order::processDataset(path), Van::processDataset(path)};
+    INSTRUMENT_PHASE(LOAD);
+
+    std::optional<Dataset> dataset;
+
+    if (isBinaryUpToDate(path))
+        dataset = loadBinary(path);
+
+    if (!dataset)
+        dataset = loadText(path);
+
+    // Only written when the contents changed since the last load
+    if (_keptHash(path) != dataset->hash)
+        _keepHash(path, dataset->hash);
+
+    return std::move(*dataset);
+}
+
+bool Dataset::convertToBinary(const std::string &path) {
+    Dataset dataset = loadText(path);
+
+    std::ofstream out{DATASETS_PATH + path + BINARY_FILE, std::ios::binary};
+
+    if (!out.is_open())
+        return false;
+
+    std::vector<uint32_t> maxVolumes, maxWeights, costs;
+    for (const Van &v : dataset.vans) {
+        maxVolumes.push_back(v.getMaxVolume());
+        maxWeights.push_back(v.getMaxWeight());
+        costs.push_back(v.getCost());
+    }
+
+    out.write(BINARY_MAGIC.data(), BINARY_MAGIC.size());
+    writeLittleEndian<uint32_t>(out, BINARY_VERSION);
+    writeLittleEndian<uint64_t>(out, dataset.orders.size());
+    writeLittleEndian<uint64_t>(out, dataset.vans.size());
+
+    writeColumn(out, dataset.orders.getVolumes());
+    writeColumn(out, dataset.orders.getWeights());
+    writeColumn(out, dataset.orders.getRewards());
+    writeColumn(out, dataset.orders.getDurations());
+
+    writeColumn(out, maxVolumes);
+    writeColumn(out, maxWeights);
+    writeColumn(out, costs);
+
+    return out.good();
 }
 
 Dataset Dataset::generate(const std::string &name,
                           const DatasetGenerationParams &params) {
+    // Results of what was there before are never used again
+    if (std::optional<uint64_t> hash = _keptHash(name))
+        ResultCache::global().invalidate(*hash);
+
     std::filesystem::create_directory({DATASETS_PATH + name});
 
-    return {
-        Order::generateDataset(name, params),
+    Dataset dataset{
+        OrderTable::generateDataset(name, params),
         Van::generateDataset(name, params),
     };
+
+    _keepHash(name, dataset.hash);
+    return dataset;
 }
 
 std::vector<std::string> Dataset::getAvailableDatasets() {
@@ -0,0 +1,107 @@
+#include "../includes/constants.hpp"
+#include "../includes/filewriter.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+FileWriter::FileWriter(const std::string &path)
+    : file(path, std::ios::binary) {
+    ok = file.is_open();
+    buffer.reserve(FILE_WRITER_BUFFER_SIZE);
+}
+
+FileWriter::~FileWriter() { flush(); }
+
+bool FileWriter::hasFile() const { return file.is_open(); }
+
+void FileWriter::writeToFile(std::string_view text) {
+    file.write(text.data(), text.size());
+    ok = ok && file.good();
+}
+#else
+FileWriter::FileWriter(const std::string &path)
+    : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+    ok = fd >= 0;
+    buffer.reserve(FILE_WRITER_BUFFER_SIZE);
+}
+
+FileWriter::~FileWriter() {
+    flush();
+
+    if (fd >= 0)
+        close(fd);
+}
+
+bool FileWriter::hasFile() const { return fd >= 0; }
+
+void FileWriter::writeToFile(std::string_view text) {
+    // write() may stop early or be interrupted by a signal, so it's called
+    // until everything was written
+    while (!text.empty()) {
+        ssize_t written = ::write(fd, text.data(), text.size());
+
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written < 0) {
+            ok = false;
+            return;
+        }
+
+        text.remove_prefix(written);
+    }
+}
+#endif
+
+void FileWriter::flushIfFull() {
+    if (buffer.size() >= FILE_WRITER_BUFFER_SIZE)
+        flush();
+}
+
+bool FileWriter::good() const { return ok; }
+
+std::string_view FileWriter::getContents() const { return buffer; }
+
+void FileWriter::flush() {
+    if (!hasFile())
+        return;
+
+    writeToFile(buffer);
+    buffer.clear();
+}
+
+FileWriter &FileWriter::operator<<(std::string_view text) {
+    if (hasFile() && text.size() >= FILE_WRITER_BUFFER_SIZE) {
+        flush();
+        writeToFile(text);
+    } else {
+        buffer.append(text);
+        flushIfFull();
+    }
+
+    return *this;
+}
+
+FileWriter &FileWriter::operator<<(char c) {
+    buffer.push_back(c);
+    flushIfFull();
+
+    return *this;
+}
+
+FileWriter &FileWriter::operator<<(double value) {
+    // Streams print 6 significant digits by default, like printf's %g
+    char digits[32];
+    char *end = std::to_chars(digits, digits + sizeof(digits), value,
+                              std::chars_format::general, 6)
+                    .ptr;
+
+    buffer.append(digits, end);
+    flushIfFull();
+
+    return *this;
+}
@@ -0,0 +1,96 @@
+#include "../includes/fitmask.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FIT_MASK_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Implementation of fitMask() for a specific instruction set.
+ */
+using FitMaskFunction = uint32_t (*)(const uint32_t *, const uint32_t *,
+                                     uint32_t, uint32_t);
+
+static uint32_t fitMaskScalar(const uint32_t *volumes, const uint32_t *weights,
+                              uint32_t vol, uint32_t w) {
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < FIT_MASK_WIDTH; ++i)
+        mask |= (uint32_t)(volumes[i] >= vol && weights[i] >= w) << i;
+
+    return mask;
+}
+
+#ifdef FIT_MASK_X86
+static uint32_t fitMaskSSE2(const uint32_t *volumes, const uint32_t *weights,
+                            uint32_t vol, uint32_t w) {
+    // SSE2 only compares signed integers, flipping the sign bit makes that
+    // work for unsigned ones
+    const __m128i sign = _mm_set1_epi32(INT32_MIN);
+    const __m128i v = _mm_xor_si128(_mm_set1_epi32(vol), sign);
+    const __m128i wt = _mm_xor_si128(_mm_set1_epi32(w), sign);
+
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < FIT_MASK_WIDTH; i += 4) {
+        __m128i vols = _mm_xor_si128(
+            _mm_loadu_si128((const __m128i *)(volumes + i)), sign);
+        __m128i weis = _mm_xor_si128(
+            _mm_loadu_si128((const __m128i *)(weights + i)), sign);
+
+        __m128i tooBig =
+            _mm_or_si128(_mm_cmpgt_epi32(v, vols), _mm_cmpgt_epi32(wt, weis));
+
+        mask |= (uint32_t)(~_mm_movemask_ps(_mm_castsi128_ps(tooBig)) & 0xF)
+                << i;
+    }
+
+    return mask;
+}
+
+__attribute__((target("avx2"))) static uint32_t
+fitMaskAVX2(const uint32_t *volumes, const uint32_t *weights, uint32_t vol,
+            uint32_t w) {
+    const __m256i v = _mm256_set1_epi32(vol);
+    const __m256i wt = _mm256_set1_epi32(w);
+
+    uint32_t mask = 0;
+
+    for (size_t i = 0; i < FIT_MASK_WIDTH; i += 8) {
+        __m256i vols = _mm256_loadu_si256((const __m256i *)(volumes + i));
+        __m256i weis = _mm256_loadu_si256((const __m256i *)(weights + i));
+
+        // x >= y if max(x, y) == x
+        __m256i fits =
+            _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(vols, v), vols),
+                             _mm256_cmpeq_epi32(_mm256_max_epu32(weis, wt), weis));
+
+        mask |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(fits)) << i;
+    }
+
+    return mask;
+}
+#endif // FIT_MASK_X86
+
+/**
+ * @brief Picks the best implementation of fitMask() for this processor.
+ */
+static FitMaskFunction selectFitMask() {
+#ifdef FIT_MASK_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return fitMaskAVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return fitMaskSSE2;
+#endif
+
+    return fitMaskScalar;
+}
+
+static const FitMaskFunction FIT_MASK = selectFitMask();
+
+uint32_t fitMask(const uint32_t *volumes, const uint32_t *weights, uint32_t vol,
+                 uint32_t w) {
+    return FIT_MASK(volumes, weights, vol, w);
+}
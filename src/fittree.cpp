@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <bit>
+
+#include "../includes/fitmask.hpp"
+#include "../includes/fittree.hpp"
+#include "../includes/instrumentation.hpp"
+
+FitTree::FitTree(std::span<const Van> vans,
+                 std::pmr::memory_resource *resource)
+    : size(vans.size()),
+      leaves(std::bit_ceil(
+          std::max<size_t>((size + FIT_MASK_WIDTH - 1) / FIT_MASK_WIDTH, 1))),
+      volumes(leaves * FIT_MASK_WIDTH, 0, resource),
+      weights(leaves * FIT_MASK_WIDTH, 0, resource),
+      volume(2 * leaves, 0, resource), weight(2 * leaves, 0, resource) {
+    for (size_t i = 0; i < size; ++i) {
+        volumes[i] = vans[i].getMaxVolume() - vans[i].getCurrentVolume();
+        weights[i] = vans[i].getMaxWeight() - vans[i].getCurrentWeight();
+    }
+
+    for (size_t leaf = leaves; leaf < 2 * leaves; ++leaf)
+        pullBlock(leaf);
+
+    for (size_t node = leaves - 1; node > 0; --node)
+        pull(node);
+}
+
+void FitTree::pullBlock(size_t leaf) {
+    auto begin = (leaf - leaves) * FIT_MASK_WIDTH;
+
+    volume[leaf] = *std::max_element(volumes.begin() + begin,
+                                     volumes.begin() + begin + FIT_MASK_WIDTH);
+    weight[leaf] = *std::max_element(weights.begin() + begin,
+                                     weights.begin() + begin + FIT_MASK_WIDTH);
+}
+
+void FitTree::pull(size_t node) {
+    volume[node] = std::max(volume[2 * node], volume[2 * node + 1]);
+    weight[node] = std::max(weight[2 * node], weight[2 * node + 1]);
+}
+
+size_t FitTree::find(size_t node, uint32_t vol, uint32_t w) const {
+    if (volume[node] < vol || weight[node] < w)
+        return npos;
+
+    if (node < leaves) {
+        size_t i = find(2 * node, vol, w);
+        return i != npos ? i : find(2 * node + 1, vol, w);
+    }
+
+    size_t begin = (node - leaves) * FIT_MASK_WIDTH;
+    uint32_t mask = fitMask(&volumes[begin], &weights[begin], vol, w);
+
+    if (mask == 0)
+        return npos;
+
+    size_t i = begin + std::countr_zero(mask);
+
+    // Padding vans have no capacity left, but empty orders still fit there
+    return i < size ? i : npos;
+}
+
+size_t FitTree::find(uint32_t vol, uint32_t w) const {
+    INSTRUMENT_COUNT(FIT_CHECKS, 1);
+
+    return size == 0 ? npos : find(1, vol, w);
+}
+
+void FitTree::update(size_t i, const Van &van) {
+    update(i, van.getMaxVolume() - van.getCurrentVolume(),
+           van.getMaxWeight() - van.getCurrentWeight());
+}
+
+void FitTree::update(size_t i, uint32_t vol, uint32_t w) {
+    volumes[i] = vol;
+    weights[i] = w;
+
+    size_t node = leaves + i / FIT_MASK_WIDTH;
+    pullBlock(node);
+
+    for (node /= 2; node > 0; node /= 2)
+        pull(node);
+}
@@ -0,0 +1,86 @@
+#include <bit>
+#include <cstring>
+
+#include "../includes/hash.hpp"
+
+static constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87;
+static constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4F;
+static constexpr uint64_t PRIME3 = 0x165667B19E3779F9;
+static constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63;
+static constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5;
+
+/**
+ * @brief Reads an unaligned integer.
+ *
+ * @param p Where the integer is.
+ *
+ * @return The integer.
+ */
+template <class T> static T _read(const unsigned char *p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+/** @brief Mixes 8 bytes of input into an accumulator. */
+static uint64_t _round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    return std::rotl(acc, 31) * PRIME1;
+}
+
+/** @brief Mixes an accumulator into the hash. */
+static uint64_t _merge(uint64_t hash, uint64_t acc) {
+    hash ^= _round(0, acc);
+    return hash * PRIME1 + PRIME4;
+}
+
+uint64_t xxHash64(const void *data, size_t size, uint64_t seed) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    const unsigned char *end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t acc[4] = {seed + PRIME1 + PRIME2, seed + PRIME2, seed,
+                           seed - PRIME1};
+
+        // Four independent lanes of 8 bytes each
+        for (; end - p >= 32; p += 32)
+            for (size_t lane = 0; lane < 4; ++lane)
+                acc[lane] = _round(acc[lane], _read<uint64_t>(p + 8 * lane));
+
+        hash = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) +
+               std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+
+        for (uint64_t a : acc)
+            hash = _merge(hash, a);
+    } else {
+        hash = seed + PRIME5;
+    }
+
+    hash += size;
+
+    for (; end - p >= 8; p += 8) {
+        hash ^= _round(0, _read<uint64_t>(p));
+        hash = std::rotl(hash, 27) * PRIME1 + PRIME4;
+    }
+
+    if (end - p >= 4) {
+        hash ^= _read<uint32_t>(p) * PRIME1;
+        hash = std::rotl(hash, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+
+    for (; p < end; ++p) {
+        hash ^= *p * PRIME5;
+        hash = std::rotl(hash, 11) * PRIME1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
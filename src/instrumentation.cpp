@@ -0,0 +1,82 @@
+#include "../includes/instrumentation.hpp"
+
+/** @brief The metrics of each thread, see Metrics::current(). */
+static thread_local Metrics *_current = nullptr;
+
+Metrics &Metrics::current() {
+    static Metrics global;
+    return _current != nullptr ? *_current : global;
+}
+
+std::string_view Metrics::name(Phase phase) {
+    switch (phase) {
+    case Phase::LOAD:
+        return "load_ns";
+    case Phase::SORT:
+        return "sort_ns";
+    case Phase::PACK:
+        return "pack_ns";
+    case Phase::AGGREGATE:
+        return "aggregate_ns";
+    case Phase::IMPROVE:
+        return "improve_ns";
+    default:
+        return "";
+    }
+}
+
+std::string_view Metrics::name(Counter counter) {
+    switch (counter) {
+    case Counter::FIT_CHECKS:
+        return "fit_checks";
+    case Counter::PLACEMENTS:
+        return "placements";
+    case Counter::ALLOCATIONS:
+        return "allocations";
+    case Counter::MOVES:
+        return "moves";
+    default:
+        return "";
+    }
+}
+
+void Metrics::headerCSV(FileWriter &out) {
+    std::string_view separator = "";
+
+    FOR_ENUM(Phase, phase) {
+        out << separator << name(phase);
+        separator = ",";
+    }
+    FOR_ENUM(Counter, counter) {
+        out << separator << name(counter);
+    }
+}
+
+void Metrics::toCSV(FileWriter &out) const {
+    std::string_view separator = "";
+
+    FOR_ENUM(Phase, phase) {
+        out << separator << nanoseconds[(size_t)phase].load();
+        separator = ",";
+    }
+    FOR_ENUM(Counter, counter) {
+        out << separator << counts[(size_t)counter].load();
+    }
+}
+
+MetricsScope::MetricsScope(Metrics &metrics) : previous(_current) {
+    _current = &metrics;
+}
+
+MetricsScope::~MetricsScope() { _current = previous; }
+
+PhaseTimer::PhaseTimer(Phase phase)
+    : phase(phase), start(std::chrono::steady_clock::now()) {}
+
+PhaseTimer::~PhaseTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Metrics::current().nanoseconds[(size_t)phase].fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        std::memory_order_relaxed);
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+#include "../includes/constants.hpp"
+#include "../includes/instrumentation.hpp"
+#include "../includes/localsearch.hpp"
+#include "../includes/radixsort.hpp"
+#include "../includes/scenarios.hpp"
+
+LocalSearch::LocalSearch(const OrderTable &orders,
+                         std::span<const uint32_t> sequence,
+                         std::span<Van> vans, std::span<uint32_t> assignment,
+                         bool profit, std::pmr::memory_resource *resource)
+    : orders(orders), vans(vans), assignment(assignment), sequence(sequence),
+      profit(profit), initial(assignment.begin(), assignment.end(), resource),
+      volumes(vans.size(), resource), weights(vans.size(), resource),
+      counts(vans.size(), 0, resource), heads(vans.size(), NIL, resource),
+      next(orders.size(), NIL, resource),
+      previous(orders.size(), NIL, resource), sizes(orders.size(), resource),
+      open(vans.size(), resource), closed(resource) {
+    uint32_t maxVolume = 0, maxWeight = 0;
+
+    for (size_t i = 0; i < vans.size(); ++i) {
+        volumes[i] = vans[i].getMaxVolume() - vans[i].getCurrentVolume();
+        weights[i] = vans[i].getMaxWeight() - vans[i].getCurrentWeight();
+        maxVolume = std::max(maxVolume, vans[i].getMaxVolume());
+        maxWeight = std::max(maxWeight, vans[i].getMaxWeight());
+    }
+
+    for (size_t i = 0; i < orders.size(); ++i)
+        sizes[i] = (double)orders.getVolumes()[i] / std::max(maxVolume, 1u) +
+                   (double)orders.getWeights()[i] / std::max(maxWeight, 1u);
+
+    // The vans already hold their orders, only the lists are built
+    for (uint32_t order = 0; order < orders.size(); ++order) {
+        uint32_t van = assignment[order];
+
+        if (van == ScenarioResult::UNASSIGNED)
+            continue;
+
+        next[order] = heads[van];
+        if (heads[van] != NIL)
+            previous[heads[van]] = order;
+        heads[van] = order;
+        ++counts[van];
+    }
+
+    for (uint32_t van = 0; van < vans.size(); ++van)
+        refresh(van);
+}
+
+void LocalSearch::place(uint32_t order, uint32_t van) {
+    INSTRUMENT_COUNT(MOVES, 1);
+
+    assignment[order] = van;
+    volumes[van] -= orders.getVolumes()[order];
+    weights[van] -= orders.getWeights()[order];
+    ++counts[van];
+
+    previous[order] = NIL;
+    next[order] = heads[van];
+    if (heads[van] != NIL)
+        previous[heads[van]] = order;
+    heads[van] = order;
+}
+
+void LocalSearch::unplace(uint32_t order) {
+    uint32_t van = assignment[order];
+
+    assignment[order] = ScenarioResult::UNASSIGNED;
+    volumes[van] += orders.getVolumes()[order];
+    weights[van] += orders.getWeights()[order];
+    --counts[van];
+
+    if (previous[order] != NIL)
+        next[previous[order]] = next[order];
+    else
+        heads[van] = next[order];
+
+    if (next[order] != NIL)
+        previous[next[order]] = previous[order];
+}
+
+void LocalSearch::refresh(uint32_t van) {
+    if (counts[van] > 0)
+        open.update(van, volumes[van], weights[van]);
+    else
+        open.remove(van);
+}
+
+bool LocalSearch::relocate(uint32_t order) {
+    size_t van =
+        open.bestFit(orders.getVolumes()[order], orders.getWeights()[order]);
+
+    if (van == ResidualTree::npos)
+        return false;
+
+    unplace(order);
+    place(order, van);
+    refresh(van);
+    return true;
+}
+
+uint32_t LocalSearch::swap(uint32_t order) {
+    const auto &v = orders.getVolumes();
+    const auto &w = orders.getWeights();
+    uint32_t from = assignment[order];
+
+    for (size_t tries = 0; tries < LOCAL_SEARCH_SWAP_TRIES; ++tries) {
+        uint32_t other = rng.bounded(0, orders.size() - 1);
+        uint32_t to = assignment[other];
+
+        // The van being emptied isn't in the tree, and neither are the
+        // vans that are already empty
+        if (to == ScenarioResult::UNASSIGNED || to == from ||
+            sizes[other] >= sizes[order])
+            continue;
+
+        if (volumes[to] + v[other] < v[order] ||
+            weights[to] + w[other] < w[order] ||
+            volumes[from] + v[order] < v[other] ||
+            weights[from] + w[order] < w[other])
+            continue;
+
+        unplace(order);
+        unplace(other);
+        place(order, to);
+        place(other, from);
+        refresh(to);
+
+        return other;
+    }
+
+    return NIL;
+}
+
+bool LocalSearch::empty(uint32_t van) {
+    open.remove(van);
+
+    std::pmr::vector<uint32_t> pending{heads.get_allocator()};
+    for (uint32_t order = heads[van]; order != NIL; order = next[order])
+        pending.push_back(order);
+
+    for (uint32_t order : pending) {
+        // Each swap brings in a smaller order, so this ends
+        bool moved = relocate(order);
+        while (!moved && (order = swap(order)) != NIL)
+            moved = relocate(order);
+
+        // Unless it may be cheaper to leave them behind, an order that can't
+        // leave keeps the van open
+        if (!moved && !profit)
+            break;
+    }
+
+    if (counts[van] > 0 && profit) {
+        uint64_t reward = 0;
+        for (uint32_t order = heads[van]; order != NIL; order = next[order])
+            reward += orders.getRewards()[order];
+
+        if (reward < vans[van].getCost())
+            while (heads[van] != NIL)
+                unplace(heads[van]);
+    }
+
+    refresh(van);
+
+    if (counts[van] > 0)
+        return false;
+
+    closed.push_back(van);
+    return true;
+}
+
+void LocalSearch::deliverRemaining() {
+    for (uint32_t order : sequence) {
+        if (assignment[order] != ScenarioResult::UNASSIGNED)
+            continue;
+
+        uint32_t v = orders.getVolumes()[order];
+        uint32_t w = orders.getWeights()[order];
+        size_t van = open.bestFit(v, w);
+
+        // Delivering every order comes before using fewer vans, so the vans
+        // that were closed are opened again for orders that fit nowhere else
+        if (van == ResidualTree::npos && !profit) {
+            auto it = std::find_if(closed.begin(), closed.end(),
+                                   [&](uint32_t van) {
+                                       return volumes[van] >= v &&
+                                              weights[van] >= w;
+                                   });
+
+            if (it != closed.end()) {
+                van = *it;
+                closed.erase(it);
+            }
+        }
+
+        if (van == ResidualTree::npos)
+            continue;
+
+        place(order, van);
+        refresh(van);
+    }
+}
+
+void LocalSearch::run(std::chrono::steady_clock::time_point deadline) {
+    INSTRUMENT_PHASE(IMPROVE);
+
+    deliverRemaining();
+
+    for (bool improved = true;
+         improved && std::chrono::steady_clock::now() < deadline;) {
+        improved = false;
+
+        // The least loaded vans first, relative to their own capacity
+        std::pmr::vector<uint64_t> keys{heads.get_allocator()};
+        std::pmr::vector<uint32_t> candidates{heads.get_allocator()};
+
+        for (uint32_t van = 0; van < vans.size(); ++van) {
+            if (counts[van] == 0)
+                continue;
+
+            double load =
+                1 - (double)volumes[van] / vans[van].getMaxVolume() + 1 -
+                (double)weights[van] / vans[van].getMaxWeight();
+
+            // The bits of a non-negative double are ordered like its value
+            keys.push_back(std::bit_cast<uint64_t>(load));
+            candidates.push_back(van);
+        }
+
+        radixSort(keys, candidates);
+
+        for (uint32_t van : candidates) {
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+
+            if (counts[van] > 0 && empty(van))
+                improved = true;
+        }
+
+        // Orders left behind by a closed van may fit elsewhere now, and
+        // closed vans have room for the ones that fit nowhere
+        if (improved)
+            deliverRemaining();
+    }
+}
+
+void LocalSearch::finish() {
+    // Every order leaves first, so vans never go over their capacity
+    for (size_t order = 0; order < orders.size(); ++order)
+        if (initial[order] != assignment[order] &&
+            initial[order] != ScenarioResult::UNASSIGNED)
+            vans[initial[order]].removeOrder(orders[order]);
+
+    for (size_t order = 0; order < orders.size(); ++order)
+        if (initial[order] != assignment[order] &&
+            assignment[order] != ScenarioResult::UNASSIGNED)
+            vans[assignment[order]].addOrder(orders[order]);
+}
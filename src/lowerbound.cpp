@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <span>
+
+#include "../includes/arena.hpp"
+#include "../includes/lowerbound.hpp"
+
+/**
+ * @brief Computes the L1 bound over a single dimension.
+ *
+ * @param sizes The sizes of the orders.
+ * @param capacities The capacities of the vans, sorted by descending capacity.
+ *
+ * @return The fewest vans whose capacity adds up to every order, or the
+ *         number of vans if they all don't.
+ */
+static size_t _l1(std::span<const uint32_t> sizes,
+                  std::span<const uint32_t> capacities) {
+    uint64_t demand = std::accumulate(sizes.begin(), sizes.end(), 0ull);
+    uint64_t capacity = 0;
+
+    for (size_t k = 0; k < capacities.size(); ++k) {
+        if (capacity >= demand)
+            return k;
+
+        capacity += capacities[k];
+    }
+
+    return capacities.size();
+}
+
+/**
+ * @brief Computes the L2 bound over a single dimension.
+ *
+ * @details For every threshold \f$\alpha \le C / 2\f$, orders bigger than
+ *          \f$C - \alpha\f$ or than \f$C / 2\f$ each need their own van, and
+ *          the orders between \f$\alpha\f$ and \f$C / 2\f$ only fit in what
+ *          is left of the vans of the latter, or in new vans.
+ *
+ * @param sizes The sizes of the orders, sorted by ascending size.
+ * @param capacity The capacity of every van.
+ *
+ * @return The lower bound.
+ */
+static size_t _l2(std::span<const uint32_t> sizes, uint64_t capacity) {
+    if (capacity == 0)
+        return 0;
+
+    std::pmr::vector<uint64_t> prefix(sizes.size() + 1, 0, &Arena::local());
+    std::partial_sum(sizes.begin(), sizes.end(), prefix.begin() + 1);
+
+    auto sum = [&](size_t from, size_t to) { return prefix[to] - prefix[from]; };
+
+    // Orders from here on are bigger than half a van
+    size_t half = std::upper_bound(sizes.begin(), sizes.end(), capacity / 2) -
+                  sizes.begin();
+
+    size_t best = 0;
+
+    // Every order size up to half a van is a threshold, and so is 0
+    for (size_t a = 0; a <= half; ++a) {
+        if (a > 0 && a < half && sizes[a] == sizes[a - 1])
+            continue;
+
+        uint64_t alpha = a < half ? sizes[a] : 0;
+
+        size_t j3 = std::lower_bound(sizes.begin(), sizes.end(), alpha) -
+                    sizes.begin();
+        size_t j1 = std::upper_bound(sizes.begin(), sizes.end(),
+                                     capacity - alpha) -
+                    sizes.begin();
+
+        size_t big = sizes.size() - half;
+        uint64_t left = (j1 - half) * capacity - sum(half, j1);
+        uint64_t small = sum(j3, half);
+
+        size_t bound = big;
+        if (small > left)
+            bound += (small - left + capacity - 1) / capacity;
+
+        best = std::max(best, bound);
+    }
+
+    return best;
+}
+
+size_t vanLowerBound(const Dataset &dataset, size_t &deliverable) {
+    const OrderTable &orders = dataset.getOrders();
+    const std::vector<Van> &vans = dataset.getVans();
+
+    if (vans.empty()) {
+        deliverable = 0;
+        return 0;
+    }
+
+    // The vans by ascending volume, with the most weight any van from there on
+    // can carry
+    std::pmr::vector<uint32_t> vanVolumes{&Arena::local()},
+        vanWeights{&Arena::local()};
+    for (const Van &v : vans) {
+        vanVolumes.push_back(v.getMaxVolume());
+        vanWeights.push_back(v.getMaxWeight());
+    }
+
+    std::pmr::vector<uint32_t> byVolume(vans.size(), &Arena::local());
+    std::iota(byVolume.begin(), byVolume.end(), 0);
+    std::sort(byVolume.begin(), byVolume.end(), [&](uint32_t a, uint32_t b) {
+        return vanVolumes[a] < vanVolumes[b];
+    });
+
+    std::pmr::vector<uint32_t> sortedVolumes(vans.size(), &Arena::local()),
+        maxWeights(vans.size(), &Arena::local());
+    for (size_t i = vans.size(); i-- > 0;) {
+        sortedVolumes[i] = vanVolumes[byVolume[i]];
+        maxWeights[i] = std::max(vanWeights[byVolume[i]],
+                                 i + 1 < vans.size() ? maxWeights[i + 1] : 0);
+    }
+
+    uint32_t maxVolume = sortedVolumes.back();
+    uint32_t maxWeight = maxWeights.front();
+
+    std::pmr::vector<uint32_t> volumes{&Arena::local()},
+        weights{&Arena::local()};
+
+    for (size_t i = 0; i < orders.size(); ++i) {
+        uint32_t volume = orders.getVolumes()[i];
+        uint32_t weight = orders.getWeights()[i];
+
+        size_t first = std::lower_bound(sortedVolumes.begin(),
+                                        sortedVolumes.end(), volume) -
+                       sortedVolumes.begin();
+
+        if (first == vans.size() || maxWeights[first] < weight)
+            continue;
+
+        volumes.push_back(volume);
+        weights.push_back(weight);
+    }
+
+    deliverable = volumes.size();
+
+    std::sort(vanVolumes.begin(), vanVolumes.end(), std::greater{});
+    std::sort(vanWeights.begin(), vanWeights.end(), std::greater{});
+    std::sort(volumes.begin(), volumes.end());
+    std::sort(weights.begin(), weights.end());
+
+    size_t bound = std::max({
+        _l1(volumes, vanVolumes),
+        _l1(weights, vanWeights),
+        _l2(volumes, maxVolume),
+        _l2(weights, maxWeight),
+    });
+
+    return std::min(bound, vans.size());
+}
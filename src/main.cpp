@@ -1,7 +1,9 @@
 #include <filesystem>
 #include <iostream>
 #include <set>
+#include <string_view>
 
+#include "../includes/cli.hpp"
 #include "../includes/constants.hpp"
 #include "../includes/dataset.hpp"
 #include "../includes/ui.hpp"
@@ -16,6 +18,10 @@ int main(int argc, char **argv) {
                         .append("datasets/")
                         .string();
 
+    // Commands run without the interactive menu
+    if (argc > 1 && std::string_view{argv[1]} == "solve")
+        return solve(argv[0], argc - 1, argv + 1);
+
     UserInterface ui{};
 
     Dataset dataset = Dataset::load("default");
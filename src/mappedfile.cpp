@@ -0,0 +1,65 @@
+#include "../includes/mappedfile.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string &path) {
+    std::ifstream file{path, std::ios::binary};
+
+    if (!file.is_open())
+        return;
+
+    buffer.assign(std::istreambuf_iterator<char>{file}, {});
+    data = buffer.data();
+    size = buffer.size();
+    open = true;
+}
+
+MappedFile::~MappedFile() {}
+#else
+MappedFile::MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        size = info.st_size;
+        open = true;
+
+        // Empty files can't be mapped
+        if (size > 0) {
+            void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (map == MAP_FAILED) {
+                size = 0;
+                open = false;
+            } else {
+                data = static_cast<const char *>(map);
+                madvise(map, size, MADV_SEQUENTIAL);
+            }
+        }
+    }
+
+    // The mapping stays valid after the file is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr)
+        munmap(const_cast<char *>(data), size);
+}
+#endif
+
+bool MappedFile::isOpen() const { return open; }
+
+std::string_view MappedFile::getContents() const { return {data, size}; }
@@ -0,0 +1,188 @@
+#include <exception>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include "../includes/constants.hpp"
+#include "../includes/fittree.hpp"
+#include "../includes/orderstream.hpp"
+#include "../includes/ordertable.hpp"
+#include "../includes/radixsort.hpp"
+#include "../includes/residualtree.hpp"
+
+/**
+ * @brief Reads and parses orders a chunk at a time.
+ *
+ * @details Each chunk ends at the last complete line that was read, and the
+ *          rest is kept for the next one.
+ *
+ * @param in Where to read the orders from.
+ * @param queue Where to put the chunks. Closed once everything was read, and
+ *              nothing more is read if it is closed before that.
+ * @param[out] error Set if the orders couldn't be parsed.
+ */
+static void _readChunks(std::istream &in, BoundedQueue<OrderTable> &queue,
+                        std::exception_ptr &error) {
+    try {
+        std::string text, rest;
+        bool header = true;
+        uint32_t nextId = 1;
+
+        while (in) {
+            text = std::move(rest);
+            rest.clear();
+
+            size_t start = text.size();
+            text.resize(start + ORDER_STREAM_CHUNK_SIZE);
+            in.read(text.data() + start, ORDER_STREAM_CHUNK_SIZE);
+            text.resize(start + in.gcount());
+
+            if (in) {
+                size_t end = text.rfind('\n');
+
+                // A line longer than a chunk keeps growing until it ends
+                if (end == std::string::npos || end < start) {
+                    rest = std::move(text);
+                    continue;
+                }
+
+                rest = text.substr(end + 1);
+                text.resize(end + 1);
+            }
+
+            std::vector<uint32_t> volumes, weights, rewards, durations;
+            parseColumns(text, {&volumes, &weights, &rewards, &durations},
+                         header);
+            header = false;
+
+            if (volumes.empty())
+                continue;
+
+            size_t count = volumes.size();
+            if (!queue.push({std::move(volumes), std::move(weights),
+                             std::move(rewards), std::move(durations),
+                             nextId}))
+                break;
+
+            nextId += count;
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    queue.close();
+}
+
+/**
+ * @brief Stops the reader of packOrderStream() when it goes out of scope, so
+ *        the thread is joined on every way out, even if packing throws.
+ */
+struct _ReaderScope {
+    /** @brief The queue the reader puts the chunks in. */
+    BoundedQueue<OrderTable> &queue;
+    /** @brief The thread running _readChunks(). */
+    std::thread &reader;
+
+    ~_ReaderScope() {
+        // The reader may be waiting for room in the queue
+        queue.cancel();
+
+        if (reader.joinable())
+            reader.join();
+    }
+};
+
+ScenarioResult packOrderStream(std::istream &in, const std::vector<Van> &vans,
+                               StreamStrategy strat) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    // Vans by descending "max area"
+    std::pmr::vector<uint64_t> keys(vans.size());
+    std::pmr::vector<uint32_t> indices(vans.size());
+
+    for (size_t i = 0; i < vans.size(); ++i)
+        keys[i] = Van::keyByArea(vans[i]);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    radixSort(keys, indices);
+
+    std::vector<Van> sorted;
+    sorted.reserve(vans.size());
+    for (uint32_t i : indices)
+        sorted.push_back(vans[i]);
+
+    // With best fit, the first tree only holds the vans that weren't opened
+    FitTree unopened{sorted};
+    ResidualTree open{sorted.size()};
+    bool bestFit = strat == StreamStrategy::BEST_FIT;
+
+    BoundedQueue<OrderTable> queue{ORDER_STREAM_QUEUE_SIZE};
+    std::exception_ptr error;
+    std::thread reader{_readChunks, std::ref(in), std::ref(queue),
+                       std::ref(error)};
+    _ReaderScope readerScope{queue, reader};
+
+    ScenarioResult result;
+    size_t total = 0;
+    uint64_t reward = 0;
+
+    while (std::optional<OrderTable> chunk = queue.pop()) {
+        const auto &volumes = chunk->getVolumes();
+        const auto &weights = chunk->getWeights();
+
+        total += chunk->size();
+
+        for (size_t order = 0; order < chunk->size(); ++order) {
+            size_t i = bestFit ? open.bestFit(volumes[order], weights[order])
+                               : ResidualTree::npos;
+
+            if (i == ResidualTree::npos) {
+                i = unopened.find(volumes[order], weights[order]);
+
+                if (i == FitTree::npos)
+                    continue;
+            }
+
+            Van &van = sorted[i];
+            van.addOrder((*chunk)[order]);
+
+            uint32_t volumeLeft = van.getMaxVolume() - van.getCurrentVolume();
+            uint32_t weightLeft = van.getMaxWeight() - van.getCurrentWeight();
+
+            if (bestFit) {
+                unopened.update(i, 0, 0);
+                open.update(i, volumeLeft, weightLeft);
+            } else {
+                unopened.update(i, volumeLeft, weightLeft);
+            }
+
+            ++result.ordersDispatched;
+            result.deliveryTime += chunk->getDurations()[order];
+            reward += chunk->getRewards()[order];
+        }
+    }
+
+    reader.join();
+
+    if (error)
+        std::rethrow_exception(error);
+
+    for (const Van &v : sorted) {
+        if (v.getOrderCount() == 0)
+            continue;
+
+        result.vans.push_back(v);
+        result.cost += v.getCost();
+    }
+
+    result.ordersRemaining = total - result.ordersDispatched;
+    result.efficiency = (double)result.ordersDispatched / total;
+    result.reward = reward;
+    result.profit = result.reward - result.cost;
+
+    auto tend = std::chrono::high_resolution_clock::now();
+    result.runtime =
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart);
+
+    return result;
+}
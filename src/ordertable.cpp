@@ -0,0 +1,152 @@
+#include <numeric>
+
+#include "../includes/constants.hpp"
+#include "../includes/dataset.hpp"
+#include "../includes/mappedfile.hpp"
+#include "../includes/order.hpp"
+#include "../includes/ordertable.hpp"
+#include "../includes/utils.hpp"
+
+OrderTable::OrderTable(const std::vector<Order> &orders) {
+    reserve(orders.size());
+
+    for (const Order &o : orders)
+        push_back(o);
+}
+
+OrderTable::OrderTable(std::vector<uint32_t> volumes,
+                       std::vector<uint32_t> weights,
+                       std::vector<uint32_t> rewards,
+                       std::vector<uint32_t> durations, uint32_t firstId)
+    : volumes(std::move(volumes)), weights(std::move(weights)),
+      rewards(std::move(rewards)), durations(std::move(durations)),
+      ids(this->volumes.size()) {
+    std::iota(ids.begin(), ids.end(), firstId);
+}
+
+OrderTable::OrderTable(const OrderTable &table,
+                       std::span<const uint32_t> indices) {
+    reserve(indices.size());
+
+    for (uint32_t i : indices) {
+        volumes.push_back(table.volumes[i]);
+        weights.push_back(table.weights[i]);
+        rewards.push_back(table.rewards[i]);
+        durations.push_back(table.durations[i]);
+        ids.push_back(table.ids[i]);
+    }
+}
+
+OrderTable OrderTable::processDataset(const std::string &path) {
+    MappedFile dataset_file{DATASETS_PATH + path + ORDERS_FILE};
+
+    if (!dataset_file.isOpen())
+        return {};
+
+    std::vector<uint32_t> volumes, weights, rewards, durations;
+    parseColumns(dataset_file.getContents(),
+                 {&volumes, &weights, &rewards, &durations});
+
+    return {std::move(volumes), std::move(weights), std::move(rewards),
+            std::move(durations)};
+}
+
+OrderTable OrderTable::generateDataset(const std::string &name,
+                                       const DatasetGenerationParams &params) {
+    std::vector<uint32_t> volumes, weights, rewards, durations;
+
+    if (!generateColumns(DATASETS_PATH + name + ORDERS_FILE, ORDERS_HEADER,
+                         params.numberOfOrders, params.seed,
+                         {{params.minOrderVolume, params.maxOrderVolume},
+                          {params.minOrderWeight, params.maxOrderWeight},
+                          {params.minOrderReward, params.maxOrderReward},
+                          {params.minOrderDuration, params.maxOrderDuration}},
+                         {&volumes, &weights, &rewards, &durations}))
+        return {};
+
+    return {std::move(volumes), std::move(weights), std::move(rewards),
+            std::move(durations)};
+}
+
+size_t OrderTable::size() const { return ids.size(); }
+bool OrderTable::empty() const { return ids.empty(); }
+
+void OrderTable::reserve(size_t n) {
+    volumes.reserve(n);
+    weights.reserve(n);
+    rewards.reserve(n);
+    durations.reserve(n);
+    ids.reserve(n);
+}
+
+void OrderTable::push_back(const Order &order) {
+    volumes.push_back(order.getVolume());
+    weights.push_back(order.getWeight());
+    rewards.push_back(order.getReward());
+    durations.push_back(order.getDuration());
+    ids.push_back(order.getId());
+}
+
+Order OrderTable::operator[](size_t i) const {
+    return {volumes[i], weights[i], rewards[i], durations[i], ids[i]};
+}
+
+OrderSpan OrderTable::subspan(size_t begin, size_t count) const {
+    return {*this, begin, count};
+}
+
+const std::vector<uint32_t> &OrderTable::getVolumes() const { return volumes; }
+const std::vector<uint32_t> &OrderTable::getWeights() const { return weights; }
+const std::vector<uint32_t> &OrderTable::getRewards() const { return rewards; }
+const std::vector<uint32_t> &OrderTable::getDurations() const {
+    return durations;
+}
+const std::vector<uint32_t> &OrderTable::getIds() const { return ids; }
+
+uint64_t OrderTable::keyByVolumeAsc(const OrderTable &t, size_t i) {
+    return (uint64_t)t.volumes[i] << 32 | t.weights[i];
+}
+
+uint64_t OrderTable::keyByVolumeDesc(const OrderTable &t, size_t i) {
+    return ~keyByVolumeAsc(t, i);
+}
+
+uint64_t OrderTable::keyByWeightAsc(const OrderTable &t, size_t i) {
+    return (uint64_t)t.weights[i] << 32 | t.volumes[i];
+}
+
+uint64_t OrderTable::keyByWeightDesc(const OrderTable &t, size_t i) {
+    return ~keyByWeightAsc(t, i);
+}
+
+uint64_t OrderTable::keyByAreaAsc(const OrderTable &t, size_t i) {
+    return (uint64_t)t.volumes[i] * t.weights[i];
+}
+
+uint64_t OrderTable::keyByAreaDesc(const OrderTable &t, size_t i) {
+    return ~keyByAreaAsc(t, i);
+}
+
+uint64_t OrderTable::keyByDuration(const OrderTable &t, size_t i) {
+    return t.durations[i];
+}
+
+OrderSpan::OrderSpan(const OrderTable &table, size_t begin, size_t count)
+    : volumes(table.getVolumes().data() + begin, count),
+      weights(table.getWeights().data() + begin, count),
+      rewards(table.getRewards().data() + begin, count),
+      durations(table.getDurations().data() + begin, count),
+      ids(table.getIds().data() + begin, count) {}
+
+size_t OrderSpan::size() const { return ids.size(); }
+bool OrderSpan::empty() const { return ids.empty(); }
+
+Order OrderSpan::operator[](size_t i) const {
+    return {volumes[i], weights[i], rewards[i], durations[i], ids[i]};
+}
+
+std::span<const uint32_t> OrderSpan::getVolumes() const { return volumes; }
+std::span<const uint32_t> OrderSpan::getWeights() const { return weights; }
+std::span<const uint32_t> OrderSpan::getRewards() const { return rewards; }
+std::span<const uint32_t> OrderSpan::getDurations() const { return durations; }
+std::span<const uint32_t> OrderSpan::getIds() const { return ids; }
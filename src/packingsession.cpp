@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <unordered_set>
+
+#include "../includes/arena.hpp"
+#include "../includes/constants.hpp"
+#include "../includes/packingsession.hpp"
+
+/**
+ * @brief Lists the vans of a session.
+ *
+ * @param dataset The dataset the result was computed from.
+ * @param result The result.
+ *
+ * @return The vans of the result, followed by the vans of the dataset that
+ *         aren't part of it.
+ */
+static std::vector<Van> _fleet(const Dataset &dataset,
+                               const ScenarioResult &result) {
+    std::vector<Van> vans = result.vans;
+    std::unordered_set<uint32_t> ids;
+
+    for (const Van &v : vans)
+        ids.insert(v.getId());
+
+    for (const Van &v : dataset.getVans())
+        if (!ids.contains(v.getId()))
+            vans.push_back(v);
+
+    return vans;
+}
+
+PackingSession::PackingSession(const Dataset &dataset,
+                               const ScenarioResult &result)
+    : vans(_fleet(dataset, result)), fits(vans), waiting(0),
+      loads(vans.size()) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    std::vector<uint32_t> byVolume(vans.size());
+    std::iota(byVolume.begin(), byVolume.end(), 0);
+    std::sort(byVolume.begin(), byVolume.end(), [&](uint32_t a, uint32_t b) {
+        return vans[a].getMaxVolume() > vans[b].getMaxVolume();
+    });
+
+    for (uint32_t van : byVolume) {
+        capacityVolumes.push_back(vans[van].getMaxVolume());
+        capacityWeights.push_back(
+            std::max(vans[van].getMaxWeight(),
+                     capacityWeights.empty() ? 0 : capacityWeights.back()));
+
+        freeVolume += vans[van].getMaxVolume() - vans[van].getCurrentVolume();
+        freeWeight += vans[van].getMaxWeight() - vans[van].getCurrentWeight();
+    }
+
+    for (size_t van = 0; van < result.vans.size(); ++van) {
+        OrderSpan orders = result.getOrders(van);
+
+        // The vans of the result are already carrying these orders
+        for (size_t i = 0; i < orders.size(); ++i) {
+            uint32_t slot = store(orders[i]);
+
+            assignment[slot] = van;
+            positions[slot] = loads[van].size();
+            loads[van].push_back(slot);
+        }
+
+        dispatched += orders.size();
+    }
+
+    OrderSpan remaining = result.getRemainingOrders();
+
+    for (size_t i = 0; i < remaining.size(); ++i) {
+        uint32_t slot = store(remaining[i]);
+        waiting.update(slot, ~volumes[slot], ~weights[slot]);
+    }
+
+    elapsed += std::chrono::high_resolution_clock::now() - tstart;
+}
+
+uint32_t PackingSession::store(const Order &order) {
+    uint32_t slot;
+
+    if (freeSlots.empty()) {
+        slot = ids.size();
+
+        volumes.push_back(0);
+        weights.push_back(0);
+        rewards.push_back(0);
+        durations.push_back(0);
+        ids.push_back(0);
+        assignment.push_back(ScenarioResult::UNASSIGNED);
+        positions.push_back(0);
+        used.push_back(false);
+        waiting.resize(ids.size());
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    volumes[slot] = order.getVolume();
+    weights[slot] = order.getWeight();
+    rewards[slot] = order.getReward();
+    durations[slot] = order.getDuration();
+    ids[slot] = order.getId();
+    assignment[slot] = ScenarioResult::UNASSIGNED;
+    used[slot] = true;
+    slots.emplace(order.getId(), slot);
+    nextId = std::max(nextId, order.getId() + 1);
+
+    return slot;
+}
+
+Order PackingSession::orderAt(uint32_t slot) const {
+    return {volumes[slot], weights[slot], rewards[slot], durations[slot],
+            ids[slot]};
+}
+
+void PackingSession::place(uint32_t slot, uint32_t van) {
+    waiting.remove(slot);
+
+    vans[van].addOrder(orderAt(slot));
+    refresh(van);
+    freeVolume -= volumes[slot];
+    freeWeight -= weights[slot];
+
+    assignment[slot] = van;
+    positions[slot] = loads[van].size();
+    loads[van].push_back(slot);
+    ++dispatched;
+}
+
+void PackingSession::unplace(uint32_t slot) {
+    uint32_t van = assignment[slot];
+
+    vans[van].removeOrder(orderAt(slot));
+    refresh(van);
+    freeVolume += volumes[slot];
+    freeWeight += weights[slot];
+
+    // Swap with the last order of the van, so nothing else moves
+    std::vector<uint32_t> &load = loads[van];
+    load[positions[slot]] = load.back();
+    positions[load.back()] = positions[slot];
+    load.pop_back();
+
+    assignment[slot] = ScenarioResult::UNASSIGNED;
+    waiting.update(slot, ~volumes[slot], ~weights[slot]);
+    --dispatched;
+}
+
+void PackingSession::refresh(uint32_t van) {
+    fits.update(van, vans[van]);
+}
+
+bool PackingSession::fitsFleet(uint32_t slot) const {
+    // The vans with enough volume come first
+    auto end = std::upper_bound(capacityVolumes.begin(), capacityVolumes.end(),
+                                volumes[slot], std::greater<>{});
+
+    return end != capacityVolumes.begin() &&
+           capacityWeights[end - capacityVolumes.begin() - 1] >= weights[slot];
+}
+
+bool PackingSession::repair(uint32_t slot) {
+    uint64_t vol = volumes[slot], w = weights[slot];
+    size_t budget = PACKING_SESSION_REPAIR_BUDGET;
+
+    // The orders that fit nowhere else, and no order at least as big will
+    std::pair<uint32_t, uint32_t> stuck[PACKING_SESSION_REPAIR_BUDGET];
+    size_t stuckCount = 0;
+
+    // Moving orders around never makes more room in the whole fleet
+    if (vol > freeVolume || w > freeWeight || !fitsFleet(slot))
+        return false;
+
+    for (size_t k = 0; k < vans.size() && budget > 0; ++k) {
+        uint32_t van = cursor;
+        cursor = (cursor + 1) % vans.size();
+
+        const Van &v = vans[van];
+
+        if (v.getMaxVolume() < vol || v.getMaxWeight() < w)
+            continue;
+
+        uint64_t roomVolume = v.getMaxVolume() - v.getCurrentVolume();
+        uint64_t roomWeight = v.getMaxWeight() - v.getCurrentWeight();
+
+        for (size_t p = 0; p < loads[van].size() && budget > 0; ++p) {
+            uint32_t other = loads[van][p];
+
+            if (roomVolume + volumes[other] < vol ||
+                roomWeight + weights[other] < w ||
+                std::any_of(stuck, stuck + stuckCount, [&](const auto &s) {
+                    return volumes[other] >= s.first &&
+                           weights[other] >= s.second;
+                }))
+                continue;
+
+            // Only looking for a van is limited, the rest is cheap
+            --budget;
+
+            // Where the other order would go, if not back to the same van
+            fits.update(van, 0, 0);
+            size_t target = fits.find(volumes[other], weights[other]);
+            refresh(van);
+
+            if (target == FitTree::npos) {
+                stuck[stuckCount++] = {volumes[other], weights[other]};
+                continue;
+            }
+
+            unplace(other);
+            place(other, target);
+            place(slot, van);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PackingSession::refill(uint32_t van) {
+    while (true) {
+        const Van &v = vans[van];
+        size_t slot =
+            waiting.bestFit(~(v.getMaxVolume() - v.getCurrentVolume()),
+                            ~(v.getMaxWeight() - v.getCurrentWeight()));
+
+        if (slot == ResidualTree::npos)
+            return;
+
+        place(slot, van);
+    }
+}
+
+uint32_t PackingSession::insert(const Order &order) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    uint32_t id = nextId;
+    uint32_t slot = store({order.getVolume(), order.getWeight(),
+                           order.getReward(), order.getDuration(), id});
+    size_t van = fits.find(volumes[slot], weights[slot]);
+
+    if (van != FitTree::npos) {
+        place(slot, van);
+    } else if (repair(slot)) {
+        // The order it replaced may have been bigger
+        refill(assignment[slot]);
+    } else {
+        waiting.update(slot, ~volumes[slot], ~weights[slot]);
+    }
+
+    elapsed += std::chrono::high_resolution_clock::now() - tstart;
+    return id;
+}
+
+bool PackingSession::remove(uint32_t id) {
+    auto it = slots.find(id);
+
+    if (it == slots.end())
+        return false;
+
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    uint32_t slot = it->second;
+    uint32_t van = assignment[slot];
+
+    if (van != ScenarioResult::UNASSIGNED)
+        unplace(slot);
+
+    waiting.remove(slot);
+    used[slot] = false;
+    slots.erase(it);
+    freeSlots.push_back(slot);
+
+    if (van != ScenarioResult::UNASSIGNED)
+        refill(van);
+
+    elapsed += std::chrono::high_resolution_clock::now() - tstart;
+    return true;
+}
+
+bool PackingSession::contains(uint32_t id) const { return slots.contains(id); }
+
+bool PackingSession::isDelivered(uint32_t id) const {
+    auto it = slots.find(id);
+    return it != slots.end() &&
+           assignment[it->second] != ScenarioResult::UNASSIGNED;
+}
+
+size_t PackingSession::size() const { return slots.size(); }
+
+size_t PackingSession::getOrdersDispatched() const { return dispatched; }
+
+ScenarioResult PackingSession::toResult() const {
+    ArenaScope scope;
+    OrderTable orders;
+    orders.reserve(slots.size());
+
+    std::vector<uint32_t> assigned;
+    assigned.reserve(slots.size());
+
+    // Vans that don't deliver anything are left out
+    std::vector<uint32_t> index(vans.size(), ScenarioResult::UNASSIGNED);
+    std::vector<Van> result;
+
+    for (size_t van = 0; van < vans.size(); ++van) {
+        if (loads[van].empty())
+            continue;
+
+        index[van] = result.size();
+        result.push_back(vans[van]);
+    }
+
+    for (uint32_t slot = 0; slot < ids.size(); ++slot) {
+        if (!used[slot])
+            continue;
+
+        orders.push_back(orderAt(slot));
+        assigned.push_back(assignment[slot] == ScenarioResult::UNASSIGNED
+                               ? ScenarioResult::UNASSIGNED
+                               : index[assignment[slot]]);
+    }
+
+    std::vector<uint32_t> sequence(orders.size());
+    std::iota(sequence.begin(), sequence.end(), 0);
+
+    return {
+        orders,
+        sequence,
+        assigned,
+        std::move(result),
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+    };
+}
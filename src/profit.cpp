@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+#include "../includes/arena.hpp"
+#include "../includes/fittree.hpp"
+#include "../includes/profit.hpp"
+#include "../includes/radixsort.hpp"
+
+/**
+ * @brief Linear relaxation of a knapsack over a single dimension, which can
+ *        be solved for any capacity.
+ */
+class FractionalKnapsack {
+    /** @brief The total size of the densest items, for each amount of them. */
+    std::pmr::vector<uint64_t> sizes{&Arena::local()};
+    /** @brief The total value of the densest items, for each amount of them. */
+    std::pmr::vector<uint64_t> values{&Arena::local()};
+    /** @brief The value per unit of size of each item, densest first. */
+    std::pmr::vector<double> densities{&Arena::local()};
+
+public:
+    /**
+     * @brief Sorts the items by descending density.
+     *
+     * @param itemValues The value of each item.
+     * @param itemSizes The size of each item.
+     */
+    FractionalKnapsack(const std::vector<uint32_t> &itemValues,
+                       const std::vector<uint32_t> &itemSizes) {
+        std::pmr::vector<uint64_t> keys(itemValues.size(), &Arena::local());
+        std::pmr::vector<uint32_t> indices(itemValues.size(), &Arena::local());
+
+        for (size_t i = 0; i < keys.size(); ++i)
+            keys[i] = descendingRatioKey((double)itemValues[i] / itemSizes[i]);
+        std::iota(indices.begin(), indices.end(), 0);
+
+        radixSort(keys, indices);
+
+        sizes.reserve(indices.size() + 1);
+        values.reserve(indices.size() + 1);
+        densities.reserve(indices.size());
+
+        sizes.push_back(0);
+        values.push_back(0);
+
+        for (uint32_t i : indices) {
+            sizes.push_back(sizes.back() + itemSizes[i]);
+            values.push_back(values.back() + itemValues[i]);
+            densities.push_back((double)itemValues[i] / itemSizes[i]);
+        }
+    }
+
+    /**
+     * @brief Solves the relaxation for a capacity.
+     *
+     * @param capacity The capacity of the knapsack.
+     *
+     * @return The most value that fits, if items can be split.
+     */
+    double solve(uint64_t capacity) const {
+        // How many of the densest items fit whole
+        size_t k = std::upper_bound(sizes.begin(), sizes.end(), capacity) -
+                   sizes.begin() - 1;
+
+        double value = values[k];
+
+        // The next item doesn't fit, so its size isn't 0
+        if (k < densities.size())
+            value += (capacity - sizes[k]) * densities[k];
+
+        return value;
+    }
+
+    /**
+     * @return The total size of the densest items, for each amount of them,
+     *         where the solution changes slope.
+     */
+    const std::pmr::vector<uint64_t> &getBreakpoints() const { return sizes; }
+};
+
+/**
+ * @brief Computes an upper bound on the reward each van can get on its own.
+ *
+ * @param vans The vans.
+ * @param byVolume The relaxation of the orders by volume.
+ * @param byWeight The relaxation of the orders by weight.
+ *
+ * @return The upper bound of each van.
+ */
+static std::pmr::vector<double>
+_vanUpperBounds(const std::vector<Van> &vans,
+                const FractionalKnapsack &byVolume,
+                const FractionalKnapsack &byWeight) {
+    std::pmr::vector<double> bounds{&Arena::local()};
+    bounds.reserve(vans.size());
+
+    for (const Van &v : vans)
+        bounds.push_back(std::min(byVolume.solve(v.getMaxVolume()),
+                                  byWeight.solve(v.getMaxWeight())));
+
+    return bounds;
+}
+
+/**
+ * @brief Computes an upper bound on the profit of the whole fleet over a
+ *        single dimension.
+ *
+ * @details Both orders and vans can be split. Buying capacity from the vans
+ *          with the lowest cost per unit first is convex and the reward it
+ *          brings is concave, so the best profit is at one of the
+ *          breakpoints of either.
+ *
+ * @param knapsack The relaxation of the orders over the dimension.
+ * @param vans The vans.
+ * @param capacity Gets the capacity of a van in the dimension.
+ *
+ * @return The upper bound.
+ */
+static double _fleetUpperBound(const FractionalKnapsack &knapsack,
+                               const std::vector<Van> &vans,
+                               unsigned int (Van::*capacity)() const) {
+    std::pmr::vector<uint64_t> keys{&Arena::local()};
+    std::pmr::vector<uint32_t> indices{&Arena::local()};
+
+    // Vans without capacity would only add to the cost
+    for (uint32_t i = 0; i < vans.size(); ++i) {
+        if ((vans[i].*capacity)() == 0)
+            continue;
+
+        keys.push_back(~descendingRatioKey((double)vans[i].getCost() /
+                                           (vans[i].*capacity)()));
+        indices.push_back(i);
+    }
+
+    radixSort(keys, indices);
+
+    std::pmr::vector<uint64_t> capacities(1, 0, &Arena::local());
+    std::pmr::vector<uint64_t> costs(1, 0, &Arena::local());
+
+    for (uint32_t i : indices) {
+        capacities.push_back(capacities.back() + (vans[i].*capacity)());
+        costs.push_back(costs.back() + vans[i].getCost());
+    }
+
+    double best = 0;
+
+    for (size_t j = 0; j < capacities.size(); ++j)
+        best = std::max(best, knapsack.solve(capacities[j]) - costs[j]);
+
+    for (uint64_t size : knapsack.getBreakpoints()) {
+        if (size > capacities.back())
+            break;
+
+        // The cheapest way to buy this much capacity
+        size_t j = std::lower_bound(capacities.begin(), capacities.end(),
+                                    size) -
+                   capacities.begin();
+        double cost = costs[j];
+
+        if (capacities[j] > size) {
+            uint64_t missing = capacities[j] - size;
+            cost -= (double)missing * (costs[j] - costs[j - 1]) /
+                    (capacities[j] - capacities[j - 1]);
+        }
+
+        best = std::max(best, knapsack.solve(size) - cost);
+    }
+
+    return best;
+}
+
+double profitUpperBound(const Dataset &dataset) {
+    const OrderTable &orders = dataset.getOrders();
+    const std::vector<Van> &vans = dataset.getVans();
+
+    FractionalKnapsack byVolume{orders.getRewards(), orders.getVolumes()};
+    FractionalKnapsack byWeight{orders.getRewards(), orders.getWeights()};
+
+    std::pmr::vector<double> bounds = _vanUpperBounds(vans, byVolume, byWeight);
+
+    double profit = 0;
+    for (size_t i = 0; i < vans.size(); ++i)
+        profit += std::max(0.0, bounds[i] - vans[i].getCost());
+
+    return std::min({
+        profit,
+        _fleetUpperBound(byVolume, vans, &Van::getMaxVolume),
+        _fleetUpperBound(byWeight, vans, &Van::getMaxWeight),
+    });
+}
+
+ScenarioResult maximizeProfit(const Dataset &dataset) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    const OrderTable &orders = dataset.getOrders();
+    const auto &volumes = orders.getVolumes();
+    const auto &weights = orders.getWeights();
+    const auto &rewards = orders.getRewards();
+    const std::vector<Van> &allVans = dataset.getVans();
+
+    // Sizes are normalized by the capacity of the whole fleet, so volume and
+    // weight count the same
+    double totalVolume = 0, totalWeight = 0;
+    for (const Van &v : allVans) {
+        totalVolume += v.getMaxVolume();
+        totalWeight += v.getMaxWeight();
+    }
+
+    auto size = [&](uint32_t volume, uint32_t weight) {
+        return volume / totalVolume + weight / totalWeight;
+    };
+
+    std::pmr::vector<uint64_t> keys(orders.size(), &Arena::local());
+    std::pmr::vector<uint32_t> o(orders.size(), &Arena::local());
+
+    for (size_t i = 0; i < orders.size(); ++i)
+        keys[i] = descendingRatioKey(rewards[i] / size(volumes[i], weights[i]));
+    std::iota(o.begin(), o.end(), 0);
+    radixSort(keys, o);
+
+    // Vans that can't pay for themselves are never opened
+    FractionalKnapsack byVolume{rewards, volumes};
+    FractionalKnapsack byWeight{rewards, weights};
+
+    std::pmr::vector<double> bounds =
+        _vanUpperBounds(allVans, byVolume, byWeight);
+    std::pmr::vector<uint32_t> candidates{&Arena::local()};
+
+    for (uint32_t i = 0; i < allVans.size(); ++i)
+        if (bounds[i] > allVans[i].getCost())
+            candidates.push_back(i);
+
+    keys.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const Van &v = allVans[candidates[i]];
+        keys[i] = ~descendingRatioKey(
+            v.getCost() / size(v.getMaxVolume(), v.getMaxWeight()));
+    }
+    radixSort(keys, candidates);
+
+    std::pmr::vector<Van> vans{&Arena::local()};
+    for (uint32_t i : candidates)
+        vans.push_back(allVans[i]);
+
+    FitTree open{vans, &Arena::local()};
+    std::pmr::vector<uint32_t> assignment(
+        orders.size(), ScenarioResult::UNASSIGNED, &Arena::local());
+    std::pmr::vector<uint64_t> vanRewards(vans.size(), 0, &Arena::local());
+    std::pmr::vector<std::pmr::vector<uint32_t>> packed(vans.size(),
+                                                        &Arena::local());
+    std::pmr::vector<bool> dropped(vans.size(), false, &Arena::local());
+
+    // Orders that take no room also fit in the dropped vans, so they go to
+    // the spare van instead
+    auto pack = [&](uint32_t order, size_t spare) {
+        size_t i = open.find(volumes[order], weights[order]);
+
+        if (i != FitTree::npos && dropped[i])
+            i = spare;
+
+        if (i == FitTree::npos)
+            return;
+
+        vans[i].addOrder(orders[order]);
+        open.update(i, vans[i]);
+        assignment[order] = i;
+        vanRewards[i] += rewards[order];
+        packed[i].push_back(order);
+    };
+
+    for (uint32_t order : o)
+        pack(order, FitTree::npos);
+
+    std::pmr::vector<uint64_t> rank(orders.size(), &Arena::local());
+    for (size_t p = 0; p < o.size(); ++p)
+        rank[o[p]] = p;
+
+    // Vans that don't pay for themselves are dropped and only their orders
+    // are packed again. The vans left only gain orders, so they stay
+    // profitable
+    std::pmr::vector<uint32_t> pending{&Arena::local()};
+    std::pmr::vector<uint64_t> pendingKeys{&Arena::local()};
+
+    while (true) {
+        pending.clear();
+        size_t spare = FitTree::npos;
+        bool dropping = false;
+
+        for (size_t i = 0; i < vans.size(); ++i) {
+            if (dropped[i])
+                continue;
+
+            if (vanRewards[i] > vans[i].getCost()) {
+                if (spare == FitTree::npos)
+                    spare = i;
+                continue;
+            }
+
+            dropped[i] = dropping = true;
+            open.update(i, 0, 0);
+            pending.insert(pending.end(), packed[i].begin(), packed[i].end());
+            packed[i].clear();
+        }
+
+        if (!dropping)
+            break;
+
+        pendingKeys.resize(pending.size());
+        for (size_t k = 0; k < pending.size(); ++k)
+            pendingKeys[k] = rank[pending[k]];
+        radixSort(pendingKeys, pending);
+
+        for (uint32_t order : pending) {
+            assignment[order] = ScenarioResult::UNASSIGNED;
+            pack(order, spare);
+        }
+    }
+
+    // Only the vans that weren't dropped are improved
+    std::pmr::vector<uint32_t> kept(vans.size(), ScenarioResult::UNASSIGNED,
+                                    &Arena::local());
+    size_t count = 0;
+
+    for (size_t i = 0; i < vans.size(); ++i) {
+        if (dropped[i])
+            continue;
+
+        kept[i] = count;
+        vans[count] = vans[i];
+        vanRewards[count] = vanRewards[i];
+        ++count;
+    }
+
+    vans.erase(vans.begin() + count, vans.end());
+    vanRewards.resize(count);
+
+    for (uint32_t &van : assignment)
+        if (van != ScenarioResult::UNASSIGNED)
+            van = kept[van];
+
+    // Local improvement, emptying the least profitable vans first
+    std::pmr::vector<std::pmr::vector<uint32_t>> members(vans.size(),
+                                                         &Arena::local());
+    for (uint32_t order : o)
+        if (assignment[order] != ScenarioResult::UNASSIGNED)
+            members[assignment[order]].push_back(order);
+
+    std::pmr::vector<uint64_t> margins(vans.size(), &Arena::local());
+    std::pmr::vector<uint32_t> byMargin(vans.size(), &Arena::local());
+
+    for (size_t i = 0; i < vans.size(); ++i)
+        margins[i] = vanRewards[i] - vans[i].getCost();
+    std::iota(byMargin.begin(), byMargin.end(), 0);
+    radixSort(margins, byMargin);
+
+    FitTree tree{vans, &Arena::local()};
+    std::pmr::vector<bool> closed(vans.size(), false, &Arena::local());
+    std::pmr::vector<std::pair<uint32_t, size_t>> moved{&Arena::local()};
+
+    for (size_t p = 0; p < byMargin.size(); ++p) {
+        uint32_t k = byMargin[p];
+
+        // The van can't take its own orders
+        tree.update(k, 0, 0);
+        moved.clear();
+        uint64_t lost = 0;
+
+        // Orders that take no room also fit in this van and in the closed
+        // ones, so they go to an open van instead. Vans are closed in the
+        // order they are visited, so the last one is open unless it's this one
+        size_t spare = FitTree::npos;
+        for (size_t q = byMargin.size(); q-- > 0 && spare == FitTree::npos;)
+            if (q != p && !closed[byMargin[q]])
+                spare = byMargin[q];
+
+        for (uint32_t order : members[k]) {
+            size_t i = tree.find(volumes[order], weights[order]);
+
+            if (i != FitTree::npos && (i == k || closed[i]))
+                i = spare;
+
+            if (i == FitTree::npos) {
+                lost += rewards[order];
+                continue;
+            }
+
+            vans[i].addOrder(orders[order]);
+            tree.update(i, vans[i]);
+            moved.emplace_back(order, i);
+        }
+
+        if (lost < vans[k].getCost()) {
+            for (uint32_t order : members[k])
+                assignment[order] = ScenarioResult::UNASSIGNED;
+
+            for (auto [order, i] : moved) {
+                assignment[order] = i;
+                members[i].push_back(order);
+            }
+
+            members[k].clear();
+            closed[k] = true;
+        } else {
+            for (auto [order, i] : moved) {
+                vans[i].removeOrder(orders[order]);
+                tree.update(i, vans[i]);
+            }
+
+            tree.update(k, vans[k]);
+        }
+    }
+
+    // Only the vans that stayed open are part of the result
+    std::pmr::vector<uint32_t> index(vans.size(), ScenarioResult::UNASSIGNED,
+                                     &Arena::local());
+    std::vector<Van> used;
+    used.reserve(std::count(closed.begin(), closed.end(), false));
+
+    for (size_t i = 0; i < vans.size(); ++i) {
+        if (closed[i])
+            continue;
+
+        index[i] = used.size();
+        used.push_back(vans[i]);
+    }
+
+    for (uint32_t &van : assignment)
+        if (van != ScenarioResult::UNASSIGNED)
+            van = index[van];
+
+    auto tend = std::chrono::high_resolution_clock::now();
+
+    return {
+        orders,
+        o,
+        assignment,
+        std::move(used),
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
+    };
+}
@@ -0,0 +1,48 @@
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include "../includes/radixsort.hpp"
+
+void radixSort(std::pmr::vector<uint64_t> &keys,
+               std::pmr::vector<uint32_t> &indices) {
+    const size_t n = keys.size();
+
+    // Count every byte of every key in a single pass
+    std::array<std::array<size_t, 256>, sizeof(uint64_t)> counts{};
+
+    for (uint64_t key : keys)
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+            ++counts[byte][(key >> (8 * byte)) & 0xFF];
+
+    std::pmr::vector<uint64_t> keysBuffer(n, keys.get_allocator());
+    std::pmr::vector<uint32_t> indicesBuffer(n, indices.get_allocator());
+
+    for (size_t byte = 0; byte < sizeof(uint64_t); ++byte) {
+        auto &count = counts[byte];
+
+        // Every key has the same value in this byte, nothing would move
+        if (n == 0 || count[(keys[0] >> (8 * byte)) & 0xFF] == n)
+            continue;
+
+        size_t offset = 0;
+        for (size_t &c : count) {
+            size_t next = offset + c;
+            c = offset;
+            offset = next;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = count[(keys[i] >> (8 * byte)) & 0xFF]++;
+            keysBuffer[pos] = keys[i];
+            indicesBuffer[pos] = indices[i];
+        }
+
+        keys.swap(keysBuffer);
+        indices.swap(indicesBuffer);
+    }
+}
+
+uint64_t descendingRatioKey(double ratio) {
+    return ~(std::isnan(ratio) ? 0 : std::bit_cast<uint64_t>(ratio));
+}
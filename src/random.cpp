@@ -0,0 +1,41 @@
+#include "../includes/random.hpp"
+
+/** @brief The increment of splitmix64, derived from the golden ratio. */
+static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15;
+
+uint64_t splitmix64(uint64_t x) {
+    x += GOLDEN_GAMMA;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+
+SplitMix64::SplitMix64(uint64_t seed, uint64_t stream)
+    : state(splitmix64(seed ^ splitmix64(stream))) {}
+
+uint64_t SplitMix64::next() {
+    uint64_t x = state;
+    state += GOLDEN_GAMMA;
+
+    return splitmix64(x);
+}
+
+uint32_t SplitMix64::bounded(uint32_t min, uint32_t max) {
+    uint64_t range = (uint64_t)max - min + 1;
+    uint32_t x = next() >> 32;
+
+    // Every value fits
+    if (range >> 32)
+        return x;
+
+    uint64_t m = x * range;
+
+    if ((uint32_t)m < range) {
+        uint32_t threshold = (uint32_t)-range % range;
+
+        while ((uint32_t)m < threshold)
+            m = (uint64_t)(uint32_t)(next() >> 32) * range;
+    }
+
+    return min + (m >> 32);
+}
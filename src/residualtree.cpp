@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <limits>
+
+#include "../includes/instrumentation.hpp"
+#include "../includes/random.hpp"
+#include "../includes/residualtree.hpp"
+
+ResidualTree::ResidualTree(size_t size, std::pmr::memory_resource *resource)
+    : left(size, NIL, resource), right(size, NIL, resource),
+      priorities(size, resource), volumes(size, 0, resource),
+      weights(size, 0, resource), maxWeights(size, 0, resource),
+      minWeights(size, 0, resource), present(size, false, resource) {
+    for (size_t i = 0; i < size; ++i)
+        priorities[i] = splitmix64(i);
+}
+
+void ResidualTree::resize(size_t size) {
+    size_t old = priorities.size();
+
+    left.resize(size, NIL);
+    right.resize(size, NIL);
+    priorities.resize(size);
+    volumes.resize(size, 0);
+    weights.resize(size, 0);
+    maxWeights.resize(size, 0);
+    minWeights.resize(size, 0);
+    present.resize(size, false);
+
+    for (size_t i = old; i < size; ++i)
+        priorities[i] = splitmix64(i);
+}
+
+void ResidualTree::normalize(uint32_t volume, uint32_t weight) {
+    volumeScale = volume > 0 ? 1.0 / volume : 1;
+    weightScale = weight > 0 ? 1.0 / weight : 1;
+}
+
+bool ResidualTree::less(uint32_t i, uint32_t vol, uint32_t w,
+                        uint32_t j) const {
+    if (volumes[i] != vol)
+        return volumes[i] < vol;
+    if (weights[i] != w)
+        return weights[i] < w;
+    return i < j;
+}
+
+void ResidualTree::pull(uint32_t node) {
+    uint32_t hi = weights[node], lo = weights[node];
+
+    if (left[node] != NIL) {
+        hi = std::max(hi, maxWeights[left[node]]);
+        lo = std::min(lo, minWeights[left[node]]);
+    }
+    if (right[node] != NIL) {
+        hi = std::max(hi, maxWeights[right[node]]);
+        lo = std::min(lo, minWeights[right[node]]);
+    }
+
+    maxWeights[node] = hi;
+    minWeights[node] = lo;
+}
+
+void ResidualTree::split(uint32_t node, uint32_t i, uint32_t &l,
+                         uint32_t &r) {
+    if (node == NIL) {
+        l = r = NIL;
+        return;
+    }
+
+    if (less(node, volumes[i], weights[i], i)) {
+        split(right[node], i, right[node], r);
+        l = node;
+    } else {
+        split(left[node], i, l, left[node]);
+        r = node;
+    }
+
+    pull(node);
+}
+
+uint32_t ResidualTree::merge(uint32_t l, uint32_t r) {
+    if (l == NIL)
+        return r;
+    if (r == NIL)
+        return l;
+
+    if (priorities[l] > priorities[r]) {
+        right[l] = merge(right[l], r);
+        pull(l);
+        return l;
+    }
+
+    left[r] = merge(l, left[r]);
+    pull(r);
+    return r;
+}
+
+uint32_t ResidualTree::erase(uint32_t node, uint32_t i) {
+    if (node == i)
+        return merge(left[node], right[node]);
+
+    if (less(node, volumes[i], weights[i], i))
+        right[node] = erase(right[node], i);
+    else
+        left[node] = erase(left[node], i);
+
+    pull(node);
+    return node;
+}
+
+void ResidualTree::update(size_t i, uint32_t vol, uint32_t w) {
+    if (present[i])
+        root = erase(root, i);
+
+    present[i] = true;
+    volumes[i] = vol;
+    weights[i] = maxWeights[i] = minWeights[i] = w;
+    left[i] = right[i] = NIL;
+
+    uint32_t l, r;
+    split(root, i, l, r);
+    root = merge(merge(l, i), r);
+}
+
+void ResidualTree::remove(size_t i) {
+    if (!present[i])
+        return;
+
+    root = erase(root, i);
+    present[i] = false;
+}
+
+size_t ResidualTree::lowest(uint32_t node, uint32_t vol, uint32_t w) const {
+    if (node == NIL || maxWeights[node] < w)
+        return npos;
+
+    // Everything on the left has even less volume
+    if (volumes[node] < vol)
+        return lowest(right[node], vol, w);
+
+    size_t i = lowest(left[node], vol, w);
+
+    if (i != npos)
+        return i;
+    if (weights[node] >= w)
+        return node;
+
+    return lowest(right[node], vol, w);
+}
+
+size_t ResidualTree::highest(uint32_t node, uint32_t w) const {
+    if (node == NIL || maxWeights[node] < w)
+        return npos;
+
+    size_t i = highest(right[node], w);
+
+    if (i != npos)
+        return i;
+    if (weights[node] >= w)
+        return node;
+
+    return highest(left[node], w);
+}
+
+size_t ResidualTree::bestFit(uint32_t vol, uint32_t w) const {
+    INSTRUMENT_COUNT(FIT_CHECKS, 1);
+
+    return lowest(root, vol, w);
+}
+
+size_t ResidualTree::worstFit(uint32_t vol, uint32_t w) const {
+    INSTRUMENT_COUNT(FIT_CHECKS, 1);
+
+    // The van with the most volume that can carry the weight
+    size_t i = highest(root, w);
+
+    return i != npos && volumes[i] >= vol ? i : npos;
+}
+
+void ResidualTree::aligned(uint32_t node, uint32_t vol, uint32_t w,
+                           uint32_t hi, double &best, size_t &found) const {
+    if (node == NIL || maxWeights[node] < w || hi < vol)
+        return;
+
+    double v = vol * volumeScale * volumeScale;
+    double u = w * weightScale * weightScale;
+
+    // No van under this node can score more than its largest capacities
+    if (hi * v + maxWeights[node] * u <= best)
+        return;
+
+    // Vans on the right have more volume, so they are tried first
+    aligned(right[node], vol, w, hi, best, found);
+
+    if (volumes[node] < vol)
+        return;
+
+    double score = volumes[node] * v + weights[node] * u;
+    if (weights[node] >= w && score > best) {
+        best = score;
+        found = node;
+    }
+
+    aligned(left[node], vol, w, volumes[node], best, found);
+}
+
+void ResidualTree::nearest(uint32_t node, uint32_t vol, uint32_t w,
+                           uint32_t lo, double &best, size_t &found) const {
+    if (node == NIL || maxWeights[node] < w)
+        return;
+
+    // No van under this node can be closer than its smallest capacities
+    double dv = ((double)std::max(lo, vol) - vol) * volumeScale;
+    double dw = ((double)std::max(minWeights[node], w) - w) * weightScale;
+
+    if (dv * dv + dw * dw >= best)
+        return;
+
+    // Everything on the left has even less volume
+    if (volumes[node] >= vol) {
+        nearest(left[node], vol, w, lo, best, found);
+
+        dv = ((double)volumes[node] - vol) * volumeScale;
+        dw = ((double)weights[node] - w) * weightScale;
+
+        double distance = dv * dv + dw * dw;
+        if (weights[node] >= w && distance < best) {
+            best = distance;
+            found = node;
+        }
+    }
+
+    nearest(right[node], vol, w, volumes[node], best, found);
+}
+
+size_t ResidualTree::mostAligned(uint32_t vol, uint32_t w) const {
+    INSTRUMENT_COUNT(FIT_CHECKS, 1);
+
+    double best = -1;
+    size_t found = npos;
+    aligned(root, vol, w, std::numeric_limits<uint32_t>::max(), best, found);
+
+    return found;
+}
+
+size_t ResidualTree::closest(uint32_t vol, uint32_t w) const {
+    INSTRUMENT_COUNT(FIT_CHECKS, 1);
+
+    double best = std::numeric_limits<double>::infinity();
+    size_t found = npos;
+    nearest(root, vol, w, 0, best, found);
+
+    return found;
+}
@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+
+#include "../includes/constants.hpp"
+#include "../includes/filewriter.hpp"
+#include "../includes/hash.hpp"
+#include "../includes/mappedfile.hpp"
+#include "../includes/resultcache.hpp"
+
+/** @brief The first bytes of the file of a cached result. */
+static const std::string RESULT_CACHE_MAGIC = "DAPR";
+
+/**
+ * @brief The start of the file of a cached result.
+ *
+ * @details Followed by the index in the dataset of each order of the result,
+ *          as 4 byte integers, then by ScenarioResult#offsets, as 8 byte
+ *          integers, and by the index in the dataset of each van, as 4 byte
+ *          integers. Everything is in the byte order of the machine, the
+ *          files aren't meant to be shared.
+ */
+struct CachedResultHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t orders;
+    uint64_t vans;
+    int32_t ordersDispatched;
+    int32_t ordersRemaining;
+    int32_t cost;
+    int32_t reward;
+    int32_t profit;
+    uint32_t hasBound;
+    uint32_t hasGap;
+    double deliveryTime;
+    double efficiency;
+    double bound;
+    double gap;
+    int64_t runtime;
+};
+
+/**
+ * @brief Appends the bytes of some values to a writer.
+ *
+ * @param out The writer.
+ * @param values The values.
+ * @param n How many values there are.
+ */
+template <class T>
+static void _writeBytes(FileWriter &out, const T *values, size_t n) {
+    out << std::string_view{reinterpret_cast<const char *>(values),
+                            n * sizeof(T)};
+}
+
+/**
+ * @brief Reads the bytes of some values.
+ *
+ * @param p Where the values start, moved to where they end.
+ * @param values Where to store the values.
+ */
+template <class T>
+static void _readBytes(const char *&p, std::vector<T> &values) {
+    if (!values.empty())
+        std::memcpy(values.data(), p, values.size() * sizeof(T));
+
+    p += values.size() * sizeof(T);
+}
+
+size_t ResultCache::KeyHash::operator()(const Key &key) const {
+    uint32_t fields[] = {(uint32_t)key.scenario, (uint32_t)key.strategy};
+    return xxHash64(fields, sizeof(fields), key.dataset);
+}
+
+std::string ResultCache::path(const Key &key) {
+    char hex[16];
+    auto [end, ec] = std::to_chars(hex, hex + sizeof(hex), key.dataset, 16);
+
+    std::string name(sizeof(hex) - (end - hex), '0');
+    name.append(hex, end);
+
+    return DATASETS_PATH + RESULT_CACHE_PATH + name + '-' +
+           std::to_string(key.scenario) + '-' + std::to_string(key.strategy) +
+           ".bin";
+}
+
+std::optional<ScenarioResult> ResultCache::read(const Key &key,
+                                                const Dataset &dataset) {
+    MappedFile file{path(key)};
+
+    if (!file.isOpen())
+        return {};
+
+    std::string_view contents = file.getContents();
+    CachedResultHeader header;
+
+    if (contents.size() < sizeof(header))
+        return {};
+
+    std::memcpy(&header, contents.data(), sizeof(header));
+
+    size_t expected = sizeof(header) + header.orders * sizeof(uint32_t) +
+                      (header.vans + 1) * sizeof(uint64_t) +
+                      header.vans * sizeof(uint32_t);
+
+    if (RESULT_CACHE_MAGIC.compare(0, 4, header.magic, 4) != 0 ||
+        header.version != RESULT_CACHE_VERSION || contents.size() != expected)
+        return {};
+
+    const char *p = contents.data() + sizeof(header);
+
+    std::vector<uint32_t> orderIndices(header.orders);
+    std::vector<uint64_t> offsets(header.vans + 1);
+    std::vector<uint32_t> vanIndices(header.vans);
+
+    _readBytes(p, orderIndices);
+    _readBytes(p, offsets);
+    _readBytes(p, vanIndices);
+
+    // The dataset has the same contents, but the file may still be damaged
+    const OrderTable &orders = dataset.getOrders();
+    const std::vector<Van> &vans = dataset.getVans();
+
+    if (std::any_of(orderIndices.begin(), orderIndices.end(),
+                    [&](uint32_t i) { return i >= orders.size(); }) ||
+        std::any_of(vanIndices.begin(), vanIndices.end(),
+                    [&](uint32_t i) { return i >= vans.size(); }) ||
+        !std::is_sorted(offsets.begin(), offsets.end()) ||
+        offsets.back() > header.orders)
+        return {};
+
+    ScenarioResult result;
+    result.orders = {orders, orderIndices};
+    result.offsets.assign(offsets.begin(), offsets.end());
+
+    for (size_t v = 0; v < vanIndices.size(); ++v) {
+        Van van = vans[vanIndices[v]];
+
+        for (size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+            van.addOrder(result.orders[i]);
+
+        result.vans.push_back(van);
+    }
+
+    result.ordersDispatched = header.ordersDispatched;
+    result.ordersRemaining = header.ordersRemaining;
+    result.cost = header.cost;
+    result.reward = header.reward;
+    result.profit = header.profit;
+    result.deliveryTime = header.deliveryTime;
+    result.efficiency = header.efficiency;
+    result.runtime = std::chrono::microseconds{header.runtime};
+
+    if (header.hasBound)
+        result.bound = header.bound;
+    if (header.hasGap)
+        result.gap = header.gap;
+
+    return result;
+}
+
+void ResultCache::write(const Key &key, const Dataset &dataset,
+                        const ScenarioResult &result) {
+    const std::vector<uint32_t> &ids = result.orders.getIds();
+    const OrderTable &orders = dataset.getOrders();
+    const std::vector<Van> &vans = dataset.getVans();
+
+    if (!result.persistent)
+        return;
+
+    // Orders and vans are found by id, which is their index plus one
+    std::vector<uint32_t> orderIndices(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        orderIndices[i] = ids[i] - 1;
+
+        if (orderIndices[i] >= orders.size() ||
+            orders.getIds()[orderIndices[i]] != ids[i])
+            return;
+    }
+
+    std::vector<uint32_t> vanIndices(result.vans.size());
+    for (size_t v = 0; v < result.vans.size(); ++v) {
+        vanIndices[v] = result.vans[v].getId() - 1;
+
+        if (vanIndices[v] >= vans.size())
+            return;
+
+        // Ids are given out again whenever a dataset is loaded, so the van
+        // must also be the same as the one of the dataset
+        const Van &van = vans[vanIndices[v]];
+        if (van.getId() != result.vans[v].getId() ||
+            van.getMaxVolume() != result.vans[v].getMaxVolume() ||
+            van.getMaxWeight() != result.vans[v].getMaxWeight() ||
+            van.getCost() != result.vans[v].getCost())
+            return;
+    }
+
+    if (result.offsets.size() != result.vans.size() + 1)
+        return;
+
+    CachedResultHeader header{};
+    std::memcpy(header.magic, RESULT_CACHE_MAGIC.data(), 4);
+    header.version = RESULT_CACHE_VERSION;
+    header.orders = orderIndices.size();
+    header.vans = vanIndices.size();
+    header.ordersDispatched = result.ordersDispatched;
+    header.ordersRemaining = result.ordersRemaining;
+    header.cost = result.cost;
+    header.reward = result.reward;
+    header.profit = result.profit;
+    header.hasBound = result.bound.has_value();
+    header.hasGap = result.gap.has_value();
+    header.deliveryTime = result.deliveryTime;
+    header.efficiency = result.efficiency;
+    header.bound = result.bound.value_or(0);
+    header.gap = result.gap.value_or(0);
+    header.runtime = result.runtime.count();
+
+    std::vector<uint64_t> offsets(result.offsets.begin(),
+                                  result.offsets.end());
+
+    std::error_code error;
+    std::filesystem::create_directories(DATASETS_PATH + RESULT_CACHE_PATH,
+                                        error);
+
+    // Written to another file first, so a result is never read half written
+    std::string target = path(key);
+    std::string temporary = target + ".tmp";
+
+    {
+        FileWriter out{temporary};
+        _writeBytes(out, &header, 1);
+        _writeBytes(out, orderIndices.data(), orderIndices.size());
+        _writeBytes(out, offsets.data(), offsets.size());
+        _writeBytes(out, vanIndices.data(), vanIndices.size());
+        out.flush();
+
+        if (!out.good())
+            return;
+    }
+
+    std::filesystem::rename(temporary, target, error);
+}
+
+void ResultCache::remember(const Key &key, const ScenarioResult &result) {
+    std::lock_guard lock{mutex};
+
+    if (!results.insert_or_assign(key, result).second)
+        return;
+
+    age.push_back(key);
+
+    if (age.size() > RESULT_CACHE_MAX_ENTRIES) {
+        results.erase(age.front());
+        age.pop_front();
+    }
+}
+
+ResultCache &ResultCache::global() {
+    static ResultCache cache;
+    return cache;
+}
+
+std::optional<ScenarioResult> ResultCache::get(const Dataset &dataset,
+                                               int scenario, int strategy) {
+    Key key{dataset.getHash(), scenario, strategy};
+
+    {
+        std::lock_guard lock{mutex};
+        auto it = results.find(key);
+
+        if (it != results.end())
+            return it->second;
+    }
+
+    if (!RESULT_CACHE_ON_DISK)
+        return {};
+
+    std::optional<ScenarioResult> result = read(key, dataset);
+
+    if (result)
+        remember(key, *result);
+
+    return result;
+}
+
+void ResultCache::put(const Dataset &dataset, int scenario, int strategy,
+                      const ScenarioResult &result) {
+    Key key{dataset.getHash(), scenario, strategy};
+
+    remember(key, result);
+
+    if (RESULT_CACHE_ON_DISK)
+        write(key, dataset, result);
+}
+
+void ResultCache::invalidate(uint64_t dataset) {
+    {
+        std::lock_guard lock{mutex};
+
+        std::erase_if(age,
+                      [&](const Key &key) { return key.dataset == dataset; });
+        std::erase_if(results, [&](const auto &entry) {
+            return entry.first.dataset == dataset;
+        });
+    }
+
+    if (!RESULT_CACHE_ON_DISK)
+        return;
+
+    // Every file of the dataset starts with the same hash
+    std::string prefix =
+        std::filesystem::path{path({dataset, 0, 0})}.filename().string();
+    prefix.resize(prefix.find('-') + 1);
+
+    std::error_code error;
+    std::filesystem::directory_iterator it{DATASETS_PATH + RESULT_CACHE_PATH,
+                                           error};
+
+    for (; !error && it != std::filesystem::directory_iterator{};
+         it.increment(error)) {
+        std::string name = it->path().filename().string();
+
+        if (name.starts_with(prefix))
+            std::filesystem::remove(it->path(), error);
+    }
+}
@@ -1,198 +1,1171 @@
 #include <algorithm>
-#include <fstream>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <iterator>
 #include <limits>
-#include <list>
-#include <sstream>
+#include <mutex>
+#include <numeric>
 
+#include "../includes/arena.hpp"
 #include "../includes/constants.hpp"
+#include "../includes/filewriter.hpp"
+#include "../includes/fittree.hpp"
+#include "../includes/instrumentation.hpp"
+#include "../includes/localsearch.hpp"
+#include "../includes/lowerbound.hpp"
+#include "../includes/profit.hpp"
+#include "../includes/radixsort.hpp"
+#include "../includes/random.hpp"
+#include "../includes/residualtree.hpp"
+#include "../includes/resultcache.hpp"
 #include "../includes/scenarios.hpp"
 
-ScenarioResult::ScenarioResult(const std::vector<Order> &rorders,
-                               const std::vector<Van> &vans,
+ScenarioResult::ScenarioResult(const OrderTable &allOrders,
+                               std::span<const uint32_t> sequence,
+                               std::span<const uint32_t> assignment,
+                               std::vector<Van> vans,
                                const std::chrono::microseconds &runtime)
-    : remainingOrders(rorders), vans(vans), runtime(runtime) {
-    for (const Van &v : vans) {
-        ordersDispatched += v.getOrders().size();
+    : offsets(vans.size() + 2, 0), vans(std::move(vans)), runtime(runtime) {
+    INSTRUMENT_PHASE(AGGREGATE);
+
+    // Counting sort, the remaining orders go in the last bucket
+    auto bucket = [&](uint32_t order) {
+        uint32_t van = assignment[order];
+        return van == UNASSIGNED ? this->vans.size() : van;
+    };
+
+    for (uint32_t order : sequence)
+        ++offsets[bucket(order) + 1];
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::pmr::vector<size_t> next{offsets.begin(), offsets.end() - 1,
+                                  &Arena::local()};
+    std::pmr::vector<uint32_t> grouped(sequence.size(), &Arena::local());
+
+    for (uint32_t order : sequence)
+        grouped[next[bucket(order)]++] = order;
+
+    offsets.pop_back();
+    orders = {allOrders, grouped};
+
+    ordersDispatched = offsets.back();
+    ordersRemaining = orders.size() - ordersDispatched;
+
+    for (const Van &v : this->vans)
         cost += v.getCost();
 
-        for (const Order &o : v.getOrders()) {
-            deliveryTime += o.getDuration();
-            reward += o.getReward();
-        }
-    }
+    OrderSpan dispatched = orders.subspan(0, ordersDispatched);
+
+    deliveryTime = std::accumulate(dispatched.getDurations().begin(),
+                                   dispatched.getDurations().end(), 0.0);
+    reward = std::accumulate(dispatched.getRewards().begin(),
+                             dispatched.getRewards().end(), 0);
     profit = reward - cost;
 
-    efficiency =
-        (double)ordersDispatched / (ordersDispatched + remainingOrders.size());
+    efficiency = (double)ordersDispatched / orders.size();
 }
 
-std::string ScenarioResult::toCSV() const {
-    std::stringstream out{};
+OrderSpan ScenarioResult::getOrders(size_t van) const {
+    return orders.subspan(offsets.at(van), offsets.at(van + 1) - offsets[van]);
+}
+
+OrderSpan ScenarioResult::getRemainingOrders() const {
+    return orders.subspan(offsets.back(), orders.size() - offsets.back());
+}
 
+void ScenarioResult::toCSV(FileWriter &out) const {
     out << vans.size() << ',' << ordersDispatched << ','
-        << remainingOrders.size() << ',' << efficiency << ','
+        << ordersRemaining << ',' << efficiency << ','
         << ((double)deliveryTime / ordersDispatched) << ',' << cost << ','
-        << reward << ',' << profit << ',' << runtime.count();
+        << reward << ',' << profit << ',' << runtime.count() << ',';
+
+    if (gap)
+        out << *gap;
+
+    out << ',' << (int)cached;
+}
+
+/**
+ * @brief Sorts the indices of every order in a table.
+ *
+ * @tparam orderKey How to sort the orders.
+ *
+ * @param orders The orders.
+ *
+ * @return The sorted indices, in the Arena of the calling thread.
+ */
+template <OrderKey orderKey>
+std::pmr::vector<uint32_t> _sortOrders(const OrderTable &orders) {
+    INSTRUMENT_PHASE(SORT);
+
+    std::pmr::vector<uint64_t> keys(orders.size(), &Arena::local());
+    std::pmr::vector<uint32_t> indices(orders.size(), &Arena::local());
+
+    for (size_t i = 0; i < orders.size(); ++i)
+        keys[i] = orderKey(orders, i);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    radixSort(keys, indices);
+    return indices;
+}
+
+/**
+ * @brief Sorts a list of vans.
+ *
+ * @tparam vanKey How to sort the vans.
+ *
+ * @param vans The vans.
+ *
+ * @return The sorted vans, in the Arena of the calling thread.
+ */
+template <VanKey vanKey>
+std::pmr::vector<Van> _sortVans(const std::vector<Van> &vans) {
+    INSTRUMENT_PHASE(SORT);
+
+    std::pmr::vector<uint64_t> keys(vans.size(), &Arena::local());
+    std::pmr::vector<uint32_t> indices(vans.size(), &Arena::local());
+
+    for (size_t i = 0; i < vans.size(); ++i)
+        keys[i] = vanKey(vans[i]);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    radixSort(keys, indices);
+
+    std::pmr::vector<Van> sorted{&Arena::local()};
+    sorted.reserve(vans.size());
+    for (uint32_t i : indices)
+        sorted.push_back(vans[i]);
+
+    return sorted;
+}
+
+/**
+ * @brief Gives each order the first van where it fits.
+ *
+ * @param orders The orders.
+ * @param sequence The order in which the orders are given a van.
+ * @param vans The vans, in the order they are tried. The orders are added to
+ *             them.
+ * @param[out] assignment The index of the van in @p vans that is delivering
+ *                        each order, or ScenarioResult::UNASSIGNED.
+ *
+ * @return How many vans, from the start of @p vans, were used.
+ */
+static size_t _firstFitPack(const OrderTable &orders,
+                            std::span<const uint32_t> sequence,
+                            std::pmr::vector<Van> &vans,
+                            std::pmr::vector<uint32_t> &assignment) {
+    INSTRUMENT_PHASE(PACK);
 
-    return out.str();
+    const auto &volumes = orders.getVolumes();
+    const auto &weights = orders.getWeights();
+
+    assignment.assign(orders.size(), ScenarioResult::UNASSIGNED);
+    size_t used = 0;
+
+    // Giving each order the first van where it fits is the same as
+    // filling each van with every order that fits, one van at a time
+    FitTree tree{vans, &Arena::local()};
+    bool remaining = false;
+
+    for (uint32_t order : sequence) {
+        size_t i = tree.find(volumes[order], weights[order]);
+
+        if (i == FitTree::npos) {
+            remaining = true;
+            continue;
+        }
+
+        vans[i].addOrder(orders[order]);
+        tree.update(i, vans[i]);
+        assignment[order] = i;
+        used = std::max(used, i + 1);
+    }
+
+    // Every van is tried while there are orders left
+    return remaining ? vans.size() : used;
+}
+
+/**
+ * @brief Gives each order the first van where it fits.
+ *
+ * @param orders The orders.
+ * @param sequence The order in which the orders are given a van.
+ * @param vans The vans, in the order they are tried. The orders are added to
+ *             them.
+ * @param tstart When the algorithm started, to measure how long it took.
+ *
+ * @return The result of the algorithm.
+ */
+static ScenarioResult
+_firstFit(const OrderTable &orders, std::span<const uint32_t> sequence,
+          std::pmr::vector<Van> &vans,
+          std::chrono::high_resolution_clock::time_point tstart) {
+    std::pmr::vector<uint32_t> assignment{&Arena::local()};
+    size_t used = _firstFitPack(orders, sequence, vans, assignment);
+
+    auto tend = std::chrono::high_resolution_clock::now();
+
+    return {
+        orders,
+        sequence,
+        assignment,
+        {vans.begin(), vans.begin() + used},
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
+    };
 }
 
-ScenarioResult _firstFitBinPacking(std::vector<Order> o, std::vector<Van> vans,
-                                   const VanOrdering &vanOrdering,
-                                   const OrderOrdering &orderOrdering) {
+/**
+ * @brief Keeps only the vans that are delivering some order.
+ *
+ * @param vans The vans.
+ * @param[in,out] assignment The index of the van in @p vans that is
+ *                           delivering each order, or
+ *                           ScenarioResult::UNASSIGNED, changed to its index
+ *                           in the returned list.
+ *
+ * @return The vans delivering some order, in the same relative order.
+ */
+static std::vector<Van> _loadedVans(std::span<const Van> vans,
+                                    std::span<uint32_t> assignment) {
+    std::pmr::vector<uint32_t> index(vans.size(), ScenarioResult::UNASSIGNED,
+                                     &Arena::local());
+    std::vector<Van> loaded;
+
+    for (size_t i = 0; i < vans.size(); ++i) {
+        if (vans[i].getOrderCount() == 0)
+            continue;
+
+        index[i] = loaded.size();
+        loaded.push_back(vans[i]);
+    }
+
+    for (uint32_t &van : assignment)
+        if (van != ScenarioResult::UNASSIGNED)
+            van = index[van];
+
+    return loaded;
+}
+
+/**
+ * @brief Implementation of scenario1() and scenario2().
+ *
+ * @details The sort keys are template parameters so each strategy gets its own
+ *          copy of this function, where they can be inlined.
+ *
+ * @tparam orderKey How to sort the orders.
+ * @tparam vanKey How to sort the vans.
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+template <OrderKey orderKey, VanKey vanKey>
+ScenarioResult _firstFitBinPacking(const Dataset &dataset,
+                                   const ScenarioOptions &) {
     auto tstart = std::chrono::high_resolution_clock::now();
 
-    std::sort(o.begin(), o.end(), orderOrdering);
-    std::sort(vans.begin(), vans.end(), vanOrdering);
+    std::pmr::vector<uint32_t> o = _sortOrders<orderKey>(dataset.getOrders());
+    std::pmr::vector<Van> vans = _sortVans<vanKey>(dataset.getVans());
 
-    std::list<Order> orders{o.begin(), o.end()};
-    auto oi = orders.begin(), oend = orders.end();
+    return _firstFit(dataset.getOrders(), o, vans, tstart);
+}
 
-    std::vector<Van> result;
+/**
+ * @brief Shuffles a sorted list a little, by letting each element move ahead
+ *        of a few of the ones after it.
+ *
+ * @details Each element's key is its position plus a random amount, up to
+ *          ::MULTI_START_NOISE of the length of the list, like the restricted
+ *          candidate list of GRASP.
+ *
+ * @param n The length of the list.
+ * @param rng Where to draw the random amounts from.
+ *
+ * @return The positions of the list in their new order, in the Arena of the
+ *         calling thread.
+ */
+static std::pmr::vector<uint32_t> _perturb(size_t n, SplitMix64 &rng) {
+    INSTRUMENT_PHASE(SORT);
 
-    for (auto vi = vans.begin(), vend = vans.end();
-         vi != vend && !orders.empty(); ++vi) {
-        for (oi = orders.begin(); oi != oend;) {
-            if (vi->canFit(*oi)) {
-                vi->addOrder(*oi);
-                oi = orders.erase(oi);
-            } else {
-                ++oi;
-            }
+    uint32_t window = std::ceil(n * MULTI_START_NOISE);
+
+    std::pmr::vector<uint64_t> keys(n, &Arena::local());
+    std::pmr::vector<uint32_t> positions(n, &Arena::local());
+
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = i + rng.bounded(0, window);
+    std::iota(positions.begin(), positions.end(), 0);
+
+    radixSort(keys, positions);
+    return positions;
+}
+
+/**
+ * @brief Implementation of Scenario1Strategy::MULTI_START and
+ *        Scenario2Strategy::MULTI_START.
+ *
+ * @details Sorts the orders and vans once, then runs _firstFit() on slightly
+ *          shuffled copies of them, see _perturb(), in parallel with
+ *          parallelFor(). The first start uses them as they were sorted. No
+ *          new starts are made after the time budget of the options, or
+ *          after ::MULTI_START_MAX_STARTS of them. Each start allocates from the
+ *          Arena of the thread running it, and only the best result so far is
+ *          kept, with ties going to the earliest start.
+ *
+ * @tparam orderKey How to sort the orders.
+ * @tparam vanKey How to sort the vans.
+ * @tparam better Whether a result is better than another.
+ *
+ * @param dataset The dataset to use.
+ * @param options How long to keep making starts, ::MULTI_START_TIME_BUDGET
+ *                by default, and how many threads to make them on.
+ *
+ * @return The best result of every start.
+ */
+template <OrderKey orderKey, VanKey vanKey,
+          bool (*better)(const ScenarioResult &, const ScenarioResult &)>
+ScenarioResult _multiStartBinPacking(const Dataset &dataset,
+                                     const ScenarioOptions &options) {
+    const OrderTable &orders = dataset.getOrders();
+
+    auto tstart = std::chrono::high_resolution_clock::now();
+    auto deadline =
+        tstart + options.timeBudget.value_or(MULTI_START_TIME_BUDGET);
+
+    std::pmr::vector<uint32_t> o = _sortOrders<orderKey>(orders);
+    std::pmr::vector<Van> vans = _sortVans<vanKey>(dataset.getVans());
+
+    std::optional<ScenarioResult> best;
+    size_t bestStart = 0;
+    std::mutex mutex;
+    Metrics &metrics = Metrics::current();
+
+    parallelFor(MULTI_START_MAX_STARTS, [&](size_t start) {
+        if (start > 0 && std::chrono::high_resolution_clock::now() > deadline)
+            return;
+
+        MetricsScope metricsScope{metrics};
+        ArenaScope scope;
+
+        // Fixed seed, so the same starts are always the same
+        SplitMix64 rng{0, start};
+
+        std::pmr::vector<uint32_t> sequence{o, &Arena::local()};
+        std::pmr::vector<Van> startVans{vans, &Arena::local()};
+
+        if (start > 0) {
+            std::pmr::vector<uint32_t> positions = _perturb(o.size(), rng);
+            for (size_t i = 0; i < o.size(); ++i)
+                sequence[i] = o[positions[i]];
+
+            positions = _perturb(vans.size(), rng);
+            for (size_t i = 0; i < vans.size(); ++i)
+                startVans[i] = vans[positions[i]];
+        }
+
+        ScenarioResult result = _firstFit(orders, sequence, startVans, tstart);
+
+        std::lock_guard lock{mutex};
+        if (!best || better(result, *best) ||
+            (!better(*best, result) && start < bestStart)) {
+            best = std::move(result);
+            bestStart = start;
         }
+    }, options.threads);
+
+    auto tend = std::chrono::high_resolution_clock::now();
+    best->runtime =
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart);
+
+    return std::move(*best);
+}
 
-        result.push_back(*vi);
+/**
+ * @brief Whether a result of scenario1() is better than another: it delivers
+ *        more orders, or as many with fewer vans.
+ */
+static bool _fewerVans(const ScenarioResult &a, const ScenarioResult &b) {
+    if (a.ordersDispatched != b.ordersDispatched)
+        return a.ordersDispatched > b.ordersDispatched;
+
+    return a.vans.size() < b.vans.size();
+}
+
+/**
+ * @brief Whether a result of scenario2() is better than another: it makes
+ *        more profit.
+ */
+static bool _moreProfit(const ScenarioResult &a, const ScenarioResult &b) {
+    return a.profit > b.profit;
+}
+
+/**
+ * @brief Picks the open van for an order from a ResidualTree.
+ */
+using ResidualFit = size_t (ResidualTree::*)(uint32_t, uint32_t) const;
+
+/**
+ * @brief Implementation of Scenario1Strategy::BEST_FIT,
+ *        Scenario1Strategy::WORST_FIT, Scenario1Strategy::DOT_PRODUCT and
+ *        Scenario1Strategy::L2_NORM.
+ *
+ * @details Each order goes to the open van picked from a ResidualTree, which
+ *          normalizes capacities by the largest volume and weight of the
+ *          fleet. When no open van fits it, the first unopened van where it
+ *          fits is opened, found with a FitTree over the unopened vans. Only
+ *          the vans that were opened are part of the result.
+ *
+ * @tparam orderKey How to sort the orders.
+ * @tparam vanKey The order in which vans are opened.
+ * @tparam fit How to pick the open van, such as ResidualTree::bestFit().
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+template <OrderKey orderKey, VanKey vanKey, ResidualFit fit>
+ScenarioResult _residualFitBinPacking(const Dataset &dataset,
+                                      const ScenarioOptions &) {
+    const OrderTable &orders = dataset.getOrders();
+
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    std::pmr::vector<uint32_t> o = _sortOrders<orderKey>(orders);
+    std::pmr::vector<Van> vans = _sortVans<vanKey>(dataset.getVans());
+
+    const auto &volumes = orders.getVolumes();
+    const auto &weights = orders.getWeights();
+
+    FitTree unopened{vans, &Arena::local()};
+    ResidualTree open{vans.size(), &Arena::local()};
+    std::pmr::vector<uint32_t> assignment(
+        orders.size(), ScenarioResult::UNASSIGNED, &Arena::local());
+
+    uint32_t maxVolume = 0, maxWeight = 0;
+    for (const Van &van : vans) {
+        maxVolume = std::max(maxVolume, van.getMaxVolume());
+        maxWeight = std::max(maxWeight, van.getMaxWeight());
     }
+    open.normalize(maxVolume, maxWeight);
+
+    {
+        INSTRUMENT_PHASE(PACK);
+
+        for (uint32_t order : o) {
+            size_t i = (open.*fit)(volumes[order], weights[order]);
+
+            if (i == ResidualTree::npos) {
+                i = unopened.find(volumes[order], weights[order]);
+
+                if (i == FitTree::npos)
+                    continue;
+
+                unopened.update(i, 0, 0);
+            }
+
+            vans[i].addOrder(orders[order]);
+            open.update(i, vans[i].getMaxVolume() - vans[i].getCurrentVolume(),
+                        vans[i].getMaxWeight() - vans[i].getCurrentWeight());
+            assignment[order] = i;
+        }
+    }
+
+    // The vans that were opened keep their relative order
+    std::vector<Van> used = _loadedVans(vans, assignment);
+
+    auto tend = std::chrono::high_resolution_clock::now();
+
+    return {
+        orders,
+        o,
+        assignment,
+        std::move(used),
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
+    };
+}
+
+/**
+ * @brief Implementation of Scenario1Strategy::LOCAL_SEARCH and
+ *        Scenario2Strategy::LOCAL_SEARCH.
+ *
+ * @details Packs the orders with _firstFitPack(), then improves the packing
+ *          with a LocalSearch for at most the time budget of the options.
+ *          Only the vans still delivering orders are part of the result.
+ *
+ * @tparam orderKey How to sort the orders.
+ * @tparam vanKey How to sort the vans.
+ * @tparam profit Whether to maximize profit instead of minimizing vans.
+ *
+ * @param dataset The dataset to use.
+ * @param options How long to search, ::LOCAL_SEARCH_TIME_BUDGET by default.
+ *
+ * @return The result of the algorithm.
+ */
+template <OrderKey orderKey, VanKey vanKey, bool profit>
+ScenarioResult _localSearchBinPacking(const Dataset &dataset,
+                                      const ScenarioOptions &options) {
+    const OrderTable &orders = dataset.getOrders();
+
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    std::pmr::vector<uint32_t> o = _sortOrders<orderKey>(orders);
+    std::pmr::vector<Van> vans = _sortVans<vanKey>(dataset.getVans());
+
+    std::pmr::vector<uint32_t> assignment{&Arena::local()};
+    size_t used = _firstFitPack(orders, o, vans, assignment);
+
+    std::span<Van> packed{vans.data(), used};
+
+    LocalSearch search{orders, o, packed, assignment, profit, &Arena::local()};
+    search.run(std::chrono::steady_clock::now() +
+               options.timeBudget.value_or(LOCAL_SEARCH_TIME_BUDGET));
+    search.finish();
+
+    std::vector<Van> loaded = _loadedVans(packed, assignment);
 
     auto tend = std::chrono::high_resolution_clock::now();
 
     return {
-        {orders.begin(), oend},
-        result,
+        orders,
+        o,
+        assignment,
+        std::move(loaded),
+        std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
+    };
+}
+
+/**
+ * @brief Signature of the implementation of a strategy.
+ */
+using ScenarioFunction = ScenarioResult (*)(const Dataset &);
+
+/**
+ * @brief Signature of the implementation of a strategy of scenario1() or
+ *        scenario2(), which may have a budget.
+ */
+using BinPackingFunction = ScenarioResult (*)(const Dataset &,
+                                              const ScenarioOptions &);
+
+/**
+ * @brief Implementation of Scenario2Strategy::PROFIT, see maximizeProfit().
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+static ScenarioResult _maximizeProfit(const Dataset &dataset,
+                                      const ScenarioOptions &) {
+    return maximizeProfit(dataset);
+}
+
+/**
+ * @brief The implementation of each Scenario1Strategy, indexed by its value.
+ */
+constexpr BinPackingFunction SCENARIO1_STRATEGIES[] = {
+    nullptr, // BEGIN
+    _firstFitBinPacking<OrderTable::keyByVolumeAsc, Van::keyByVolume>,
+    _firstFitBinPacking<OrderTable::keyByVolumeDesc, Van::keyByVolume>,
+    _firstFitBinPacking<OrderTable::keyByWeightAsc, Van::keyByWeight>,
+    _firstFitBinPacking<OrderTable::keyByWeightDesc, Van::keyByWeight>,
+    _firstFitBinPacking<OrderTable::keyByAreaAsc, Van::keyByArea>,
+    _firstFitBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea>,
+    _residualFitBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea,
+                           &ResidualTree::bestFit>,
+    _residualFitBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea,
+                           &ResidualTree::worstFit>,
+    _multiStartBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea,
+                          _fewerVans>,
+    _residualFitBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea,
+                           &ResidualTree::mostAligned>,
+    _residualFitBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea,
+                           &ResidualTree::closest>,
+    _localSearchBinPacking<OrderTable::keyByAreaDesc, Van::keyByArea, false>,
+};
+static_assert(std::size(SCENARIO1_STRATEGIES) ==
+              (size_t)Scenario1Strategy::END);
+
+/**
+ * @brief The implementation of each Scenario2Strategy, indexed by its value.
+ */
+constexpr BinPackingFunction SCENARIO2_STRATEGIES[] = {
+    nullptr, // BEGIN
+    _firstFitBinPacking<OrderTable::keyByVolumeAsc,
+                        Van::keyByVolumeOverCost>,
+    _firstFitBinPacking<OrderTable::keyByVolumeDesc,
+                        Van::keyByVolumeOverCost>,
+    _firstFitBinPacking<OrderTable::keyByWeightAsc,
+                        Van::keyByWeightOverCost>,
+    _firstFitBinPacking<OrderTable::keyByWeightDesc,
+                        Van::keyByWeightOverCost>,
+    _firstFitBinPacking<OrderTable::keyByAreaAsc,
+                        Van::keyByAreaOverCost>,
+    _firstFitBinPacking<OrderTable::keyByAreaDesc,
+                        Van::keyByAreaOverCost>,
+    _maximizeProfit,
+    _multiStartBinPacking<OrderTable::keyByAreaDesc, Van::keyByAreaOverCost,
+                          _moreProfit>,
+    _localSearchBinPacking<OrderTable::keyByAreaDesc, Van::keyByAreaOverCost,
+                           true>,
+};
+static_assert(std::size(SCENARIO2_STRATEGIES) ==
+              (size_t)Scenario2Strategy::END);
+
+const ScenarioResult scenario1(const Dataset &dataset, Scenario1Strategy strat,
+                               const ScenarioOptions &options) {
+    ArenaScope scope;
+    ScenarioResult result =
+        SCENARIO1_STRATEGIES[(size_t)strat](dataset, options);
+
+    size_t deliverable;
+    result.bound = vanLowerBound(dataset, deliverable);
+
+    // Vans are only comparable when every order that can be delivered was
+    if ((size_t)result.ordersDispatched == deliverable)
+        result.gap = result.vans.empty()
+                         ? 0
+                         : (result.vans.size() - *result.bound) /
+                               (double)result.vans.size();
+
+    return result;
+}
+
+const ScenarioResult scenario2(const Dataset &dataset, Scenario2Strategy strat,
+                               const ScenarioOptions &options) {
+    ArenaScope scope;
+    ScenarioResult result =
+        SCENARIO2_STRATEGIES[(size_t)strat](dataset, options);
+
+    result.bound = profitUpperBound(dataset);
+    result.gap = *result.bound > 0
+                     ? (*result.bound - result.profit) / *result.bound
+                     : 0;
+
+    return result;
+}
+
+/**
+ * @brief Counts how many of the quickest orders can be delivered in a work
+ *        day, which is the most orders that can be delivered in one.
+ *
+ * @param durations The durations of the orders.
+ * @param sorted The indices of the orders, sorted by ascending duration.
+ * @param[out] time How long those orders take.
+ *
+ * @return How many orders can be delivered.
+ */
+static size_t _countQuickestOrders(const std::vector<uint32_t> &durations,
+                                   std::span<const uint32_t> sorted,
+                                   uint64_t &time) {
+    size_t count = 0;
+    time = 0;
+
+    while (count < sorted.size() &&
+           time + durations[sorted[count]] <= WORK_DAY_DURATION)
+        time += durations[sorted[count++]];
+
+    return count;
+}
+
+/**
+ * @brief Implementation of Scenario3Strategy::QUICKEST_FIRST.
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+static ScenarioResult _quickestFirst(const Dataset &dataset) {
+    auto tstart = std::chrono::high_resolution_clock::now();
+
+    const OrderTable &orders = dataset.getOrders();
+
+    std::pmr::vector<uint32_t> o =
+        _sortOrders<OrderTable::keyByDuration>(orders);
+    Van van{std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+            0};
+    std::pmr::vector<uint32_t> assignment(
+        orders.size(), ScenarioResult::UNASSIGNED, &Arena::local());
+
+    uint64_t time;
+    size_t count = _countQuickestOrders(orders.getDurations(), o, time);
+
+    for (size_t i = 0; i < count; ++i) {
+        van.addOrder(orders[o[i]]);
+        assignment[o[i]] = 0;
+    }
+
+    auto tend = std::chrono::high_resolution_clock::now();
+
+    ScenarioResult result{
+        orders,
+        o,
+        assignment,
+        {van},
         std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
     };
+
+    // The van isn't one of the dataset, even if its id is
+    result.persistent = false;
+    return result;
+}
+
+/**
+ * @brief The key of a set of orders in the knapsack of _maxReward() when how
+ *        many orders it has and their reward don't fit in a single integer
+ *        together. Sets are compared by count, then by reward.
+ */
+struct _WideKey {
+    /** @brief How many orders the set has. */
+    uint64_t count;
+    /** @brief The total reward of the set. */
+    uint64_t reward;
+
+    _WideKey operator+(const _WideKey &other) const {
+        return {count + other.count, reward + other.reward};
+    }
+
+    auto operator<=>(const _WideKey &) const = default;
+};
+
+/**
+ * @brief Finds the key of the best set of some orders that take at most each
+ *        amount of time.
+ *
+ * @tparam Key The key of a set of orders.
+ *
+ * @param keys The key of each order.
+ * @param durations How long each order takes.
+ * @param[out] best The key of the best set for each amount of time, from 0
+ *                  to its size minus one.
+ */
+template <class Key>
+static void _knapsackRow(std::span<const Key> keys,
+                         std::span<const uint32_t> durations,
+                         std::span<Key> best) {
+    std::fill(best.begin(), best.end(), Key{});
+
+    for (size_t c = 0; c < keys.size(); ++c)
+        for (size_t t = best.size() - 1; t + 1 > durations[c]; --t)
+            best[t] = std::max(best[t], best[t - durations[c]] + keys[c]);
 }
 
-const ScenarioResult scenario1(const Dataset &dataset,
-                               Scenario1Strategy strat) {
-    OrderOrdering orderOrdering;
-    VanOrdering vanOrdering;
-
-    switch (strat) {
-    case Scenario1Strategy::VOLUME_ASC:
-        orderOrdering = Order::compareByVolumeAsc;
-        vanOrdering = Van::compareByVolume;
-        break;
-    case Scenario1Strategy::VOLUME_DESC:
-        orderOrdering = Order::compareByVolumeDesc;
-        vanOrdering = Van::compareByVolume;
-        break;
-    case Scenario1Strategy::WEIGHT_ASC:
-        orderOrdering = Order::compareByWeightAsc;
-        vanOrdering = Van::compareByWeight;
-        break;
-    case Scenario1Strategy::WEIGHT_DESC:
-        orderOrdering = Order::compareByWeightDesc;
-        vanOrdering = Van::compareByWeight;
-        break;
-    case Scenario1Strategy::AREA_ASC:
-        orderOrdering = Order::compareByAreaAsc;
-        vanOrdering = Van::compareByArea;
-        break;
-    case Scenario1Strategy::AREA_DESC:
-        orderOrdering = Order::compareByAreaDesc;
-        vanOrdering = Van::compareByArea;
-        break;
-    }
-
-    return _firstFitBinPacking(dataset.getOrders(), dataset.getVans(),
-                               vanOrdering, orderOrdering);
-}
-
-const ScenarioResult scenario2(const Dataset &dataset,
-                               Scenario2Strategy strat) {
-    OrderOrdering orderOrdering;
-    VanOrdering vanOrdering;
-
-    switch (strat) {
-    case Scenario2Strategy::VOLUME_ASC:
-        orderOrdering = Order::compareByVolumeAsc;
-        vanOrdering = Van::compareByVolumeOverCost;
-        break;
-    case Scenario2Strategy::VOLUME_DESC:
-        orderOrdering = Order::compareByVolumeDesc;
-        vanOrdering = Van::compareByVolumeOverCost;
-        break;
-    case Scenario2Strategy::WEIGHT_ASC:
-        orderOrdering = Order::compareByWeightAsc;
-        vanOrdering = Van::compareByWeightOverCost;
-        break;
-    case Scenario2Strategy::WEIGHT_DESC:
-        orderOrdering = Order::compareByWeightDesc;
-        vanOrdering = Van::compareByWeightOverCost;
-        break;
-    case Scenario2Strategy::AREA_ASC:
-        orderOrdering = Order::compareByAreaAsc;
-        vanOrdering = Van::compareByAreaOverCost;
-        break;
-    case Scenario2Strategy::AREA_DESC:
-        orderOrdering = Order::compareByAreaDesc;
-        vanOrdering = Van::compareByAreaOverCost;
-        break;
-    }
-
-    return _firstFitBinPacking(dataset.getOrders(), dataset.getVans(),
-                               vanOrdering, orderOrdering);
-}
-
-const ScenarioResult scenario3(const Dataset &dataset) {
+/**
+ * @brief Finds the best set of some orders that take at most some time.
+ *
+ * @details One bit per order and second records whether the order was
+ *          picked, so the set can be found by walking back from the last
+ *          order. If those bits would take more than
+ *          ::SCENARIO3_MAX_TABLE_SIZE bytes, the best keys of each half of the
+ *          orders are found instead, without the bits, to know how much time
+ *          each half gets in the best set. Each half is then solved on its
+ *          own, like in Hirschberg's algorithm, which takes at most twice as
+ *          long but only as much memory as the bits of a smaller half.
+ *
+ * @tparam Key The key of a set of orders.
+ *
+ * @param keys The key of each order.
+ * @param durations How long each order takes.
+ * @param time How long the set may take.
+ * @param first The position of the first order in the whole list, added to
+ *              the ones that are picked.
+ * @param[out] chosen Where the positions of the orders that are picked are
+ *                    added. Must have room for all of them already, since
+ *                    the memory used here is freed.
+ */
+template <class Key>
+static void _knapsack(std::span<const Key> keys,
+                      std::span<const uint32_t> durations, size_t time,
+                      size_t first, std::pmr::vector<uint32_t> &chosen) {
+    if (keys.empty())
+        return;
+
+    ArenaScope scope;
+
+    const size_t times = time + 1;
+    const size_t words = (times + 63) / 64;
+
+    if (keys.size() == 1 ||
+        keys.size() * words * sizeof(uint64_t) <= SCENARIO3_MAX_TABLE_SIZE) {
+        // The key of the best set of orders that take at most each time
+        std::pmr::vector<Key> best(times, Key{}, &Arena::local());
+        std::pmr::vector<uint64_t> picked(keys.size() * words, 0,
+                                          &Arena::local());
+
+        for (size_t c = 0; c < keys.size(); ++c) {
+            uint32_t duration = durations[c];
+            uint64_t *row = &picked[c * words];
+
+            for (size_t t = times - 1; t + 1 > duration; --t) {
+                Key newKey = best[t - duration] + keys[c];
+                bool pick = newKey > best[t];
+
+                best[t] = pick ? newKey : best[t];
+                row[t / 64] |= (uint64_t)pick << (t % 64);
+            }
+        }
+
+        for (size_t c = keys.size(); c-- > 0;) {
+            if (picked[c * words + time / 64] >> (time % 64) & 1) {
+                chosen.push_back(first + c);
+                time -= durations[c];
+            }
+        }
+
+        return;
+    }
+
+    size_t half = keys.size() / 2;
+    size_t split = 0;
+
+    {
+        ArenaScope rows;
+        std::pmr::vector<Key> left(times, &Arena::local());
+        std::pmr::vector<Key> right(times, &Arena::local());
+
+        _knapsackRow(keys.first(half), durations.first(half),
+                     std::span{left});
+        _knapsackRow(keys.subspan(half), durations.subspan(half),
+                     std::span{right});
+
+        Key bestKey{};
+        for (size_t t = 0; t < times; ++t) {
+            if (left[t] + right[time - t] > bestKey) {
+                bestKey = left[t] + right[time - t];
+                split = t;
+            }
+        }
+    }
+
+    _knapsack(keys.first(half), durations.first(half), split, first, chosen);
+    _knapsack(keys.subspan(half), durations.subspan(half), time - split,
+              first + half, chosen);
+}
+
+/**
+ * @brief Finds the set of candidates of _maxReward() with the most orders
+ *        and the highest reward, with _knapsack().
+ *
+ * @tparam Key The key of a set of orders.
+ *
+ * @param candidates The indices of the orders that may be picked.
+ * @param durations How long each order of the dataset takes.
+ * @param key Makes the key of the order at an index of the dataset.
+ *
+ * @return The indices of the orders that were picked.
+ */
+template <class Key, class F>
+static std::pmr::vector<uint32_t>
+_bestCandidates(std::span<const uint32_t> candidates,
+                const std::vector<uint32_t> &durations, F key) {
+    std::pmr::vector<Key> keys(candidates.size(), &Arena::local());
+    std::pmr::vector<uint32_t> times(candidates.size(), &Arena::local());
+
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        keys[c] = key(candidates[c]);
+        times[c] = durations[candidates[c]];
+    }
+
+    std::pmr::vector<uint32_t> chosen{&Arena::local()};
+    chosen.reserve(candidates.size());
+
+    _knapsack(std::span<const Key>{keys}, std::span<const uint32_t>{times},
+              WORK_DAY_DURATION, 0, chosen);
+
+    for (uint32_t &c : chosen)
+        c = candidates[c];
+
+    return chosen;
+}
+
+/**
+ * @brief Implementation of Scenario3Strategy::MAX_REWARD.
+ *
+ * @details The most orders that can be delivered is known from the quickest
+ *          orders, so only the orders that can be part of a set that big are
+ *          considered. Of the orders that take the same time, only the ones
+ *          with the highest reward that could all be delivered are kept.
+ *
+ *          A knapsack over the seconds of the work day then finds, for each
+ *          amount of time, the most orders and the highest reward that fit in
+ *          it, see _knapsack(). Both are packed in a single integer when they
+ *          fit in one.
+ *
+ * @param dataset The dataset to use.
+ *
+ * @return The result of the algorithm.
+ */
+static ScenarioResult _maxReward(const Dataset &dataset) {
     auto tstart = std::chrono::high_resolution_clock::now();
 
-    std::vector<Order> orders = dataset.getOrders();
-    std::sort(orders.begin(), orders.end(), Order::compareByDuration);
+    const OrderTable &orders = dataset.getOrders();
+    const auto &durations = orders.getDurations();
+    const auto &rewards = orders.getRewards();
+
+    std::pmr::vector<uint32_t> o =
+        _sortOrders<OrderTable::keyByDuration>(orders);
     Van van{std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
             0};
+    std::pmr::vector<uint32_t> assignment(
+        orders.size(), ScenarioResult::UNASSIGNED, &Arena::local());
+
+    uint64_t time;
+    size_t count = _countQuickestOrders(durations, o, time);
+
+    // Any other order in the set is at least as slow as one of the quickest
+    uint64_t maxDuration =
+        count == 0 ? 0 : WORK_DAY_DURATION - time + durations[o[count - 1]];
+
+    std::pmr::vector<uint32_t> candidates{&Arena::local()};
+
+    for (auto group = o.begin(); group != o.end();) {
+        uint32_t duration = durations[*group];
+        auto next = std::find_if(group, o.end(), [&](uint32_t i) {
+            return durations[i] != duration;
+        });
+
+        if (duration > maxDuration)
+            break;
+
+        size_t keep = duration == 0
+                          ? next - group
+                          : std::min<size_t>({(size_t)(next - group), count,
+                                              WORK_DAY_DURATION / duration});
+
+        // Ties keep the order of the indices, like a stable sort would,
+        // without its buffer
+        auto first = candidates.insert(candidates.end(), group, next);
+        std::sort(first, candidates.end(), [&](uint32_t a, uint32_t b) {
+            return rewards[a] != rewards[b] ? rewards[a] > rewards[b] : a < b;
+        });
+        candidates.resize(candidates.size() - (next - group) + keep);
+
+        group = next;
+    }
+
+    // Sets are compared by count, then by reward, so both are packed into a
+    // single key with the count above any reward the candidates can add up to
+    uint64_t totalReward = 0;
+    for (uint32_t i : candidates)
+        totalReward += rewards[i];
+
+    const int rewardBits = std::bit_width(totalReward);
 
-    double time = 0, max_time = 8 * 3600;
+    if (rewardBits + std::bit_width(candidates.size()) <= 64)
+        candidates = _bestCandidates<uint64_t>(
+            candidates, durations, [&](uint32_t i) {
+                return ((uint64_t)1 << rewardBits) + rewards[i];
+            });
+    else
+        candidates = _bestCandidates<_WideKey>(
+            candidates, durations,
+            [&](uint32_t i) { return _WideKey{1, rewards[i]}; });
 
-    auto i = orders.begin(), end = orders.end();
-    for (; i != end && time + i->getDuration() <= max_time; ++i) {
-        van.addOrder(*i);
-        time += i->getDuration();
+    for (uint32_t i : candidates) {
+        van.addOrder(orders[i]);
+        assignment[i] = 0;
     }
 
     auto tend = std::chrono::high_resolution_clock::now();
 
-    return {
-        {i, end},
+    ScenarioResult result{
+        orders,
+        o,
+        assignment,
         {van},
         std::chrono::duration_cast<std::chrono::microseconds>(tend - tstart),
     };
+
+    // The van isn't one of the dataset, even if its id is
+    result.persistent = false;
+    return result;
 }
 
-void runAllScenarios() {
-    std::ofstream out{DATASETS_PATH + OUTPUT_FILE};
-    out << OUTPUT_HEADER;
+/**
+ * @brief The implementation of each Scenario3Strategy, indexed by its value.
+ */
+constexpr ScenarioFunction SCENARIO3_STRATEGIES[] = {
+    nullptr, // BEGIN
+    _quickestFirst,
+    _maxReward,
+};
+static_assert(std::size(SCENARIO3_STRATEGIES) ==
+              (size_t)Scenario3Strategy::END);
 
-    for (const auto &name : Dataset::getAvailableDatasets()) {
-        Dataset dataset = Dataset::load(name);
+const ScenarioResult scenario3(const Dataset &dataset,
+                               Scenario3Strategy strat) {
+    ArenaScope scope;
+    return SCENARIO3_STRATEGIES[(size_t)strat](dataset);
+}
 
-        FOR_ENUM(Scenario1Strategy, strat) {
-            auto result = scenario1(dataset, strat);
+/**
+ * @brief Checks whether a strategy stops when its time is up, so its result
+ *        depends on the machine, its load and the threads it is given.
+ *
+ * @param scenario The number of the scenario, from 1 to 3.
+ * @param strategy The value of the strategy.
+ *
+ * @return Whether the strategy has a time budget.
+ */
+static bool _timeBudgeted(int scenario, int strategy) {
+    switch (scenario) {
+    case 1:
+        return strategy == (int)Scenario1Strategy::MULTI_START ||
+               strategy == (int)Scenario1Strategy::LOCAL_SEARCH;
+    case 2:
+        return strategy == (int)Scenario2Strategy::MULTI_START ||
+               strategy == (int)Scenario2Strategy::LOCAL_SEARCH;
+    default:
+        return false;
+    }
+}
 
-            out << name << ',' << 1 << ',' << (int)strat << ','
-                << result.toCSV() << '\n';
+ScenarioResult runScenario(const Dataset &dataset, int scenario, int strategy,
+                           bool useCache, const ScenarioOptions &options) {
+    ResultCache &cache = ResultCache::global();
+    useCache = useCache && !_timeBudgeted(scenario, strategy);
+
+    if (useCache) {
+        auto tstart = std::chrono::high_resolution_clock::now();
+
+        if (std::optional<ScenarioResult> cached =
+                cache.get(dataset, scenario, strategy)) {
+            auto tend = std::chrono::high_resolution_clock::now();
+
+            cached->cached = true;
+            cached->runtime =
+                std::chrono::duration_cast<std::chrono::microseconds>(tend -
+                                                                      tstart);
+            return std::move(*cached);
         }
+    }
 
+    ScenarioResult result =
+        scenario == 1
+            ? scenario1(dataset, (Scenario1Strategy)strategy, options)
+        : scenario == 2
+            ? scenario2(dataset, (Scenario2Strategy)strategy, options)
+            : scenario3(dataset, (Scenario3Strategy)strategy);
+
+    if (useCache)
+        cache.put(dataset, scenario, strategy, result);
+
+    return result;
+}
+
+void runAllScenarios() {
+    // Loading isn't thread safe, so every dataset is loaded up front
+    std::vector<std::string> names = Dataset::getAvailableDatasets();
+    std::vector<Dataset> datasets;
+    datasets.reserve(names.size());
+
+    std::vector<Metrics> loads(names.size());
+
+    for (size_t d = 0; d < names.size(); ++d) {
+        MetricsScope metricsScope{loads[d]};
+        datasets.push_back(Dataset::load(names[d]));
+    }
+
+    // Every run is independent, so they can be done in any order as long as
+    // the results are written in the same order
+    struct Run {
+        size_t dataset;
+        int scenario;
+        int strategy;
+    };
+    std::vector<Run> runs;
+
+    for (size_t d = 0; d < datasets.size(); ++d) {
+        FOR_ENUM(Scenario1Strategy, strat) {
+            runs.push_back({d, 1, (int)strat});
+        }
         FOR_ENUM(Scenario2Strategy, strat) {
-            auto result = scenario2(dataset, strat);
+            runs.push_back({d, 2, (int)strat});
+        }
+        FOR_ENUM(Scenario3Strategy, strat) {
+            runs.push_back({d, 3, (int)strat});
+        }
+    }
+
+    std::vector<std::string> rows(runs.size());
+    std::vector<Metrics> metrics(runs.size());
+
+    // The first Scenario1Strategy that reaches the lower bound of each
+    // dataset. Later strategies can't do better, so they are skipped if it is
+    // known in time, and never written otherwise
+    std::vector<std::atomic<int>> optimal(datasets.size());
+    for (auto &strategy : optimal)
+        strategy = (int)Scenario1Strategy::END;
 
-            out << name << ',' << 2 << ',' << (int)strat << ','
-                << result.toCSV() << '\n';
+    parallelFor(runs.size(), [&](size_t i) {
+        const Run &run = runs[i];
+        const Dataset &dataset = datasets[run.dataset];
+
+        if (run.scenario == 1 && optimal[run.dataset] < run.strategy)
+            return;
+
+        MetricsScope metricsScope{metrics[i]};
+        // The runs already take every thread, and starting more would make
+        // the strategies with a budget depend on how the runs were scheduled
+        ScenarioOptions options{};
+        options.threads = 1;
+
+        ScenarioResult result =
+            runScenario(dataset, run.scenario, run.strategy, false, options);
+
+        if (run.scenario == 1 && result.gap == 0) {
+            int strategy = optimal[run.dataset];
+            while (run.strategy < strategy &&
+                   !optimal[run.dataset].compare_exchange_weak(strategy,
+                                                               run.strategy))
+                ;
         }
 
-        auto result = scenario3(dataset);
+        FileWriter row{};
+        row << names[run.dataset] << ',' << run.scenario << ','
+            << run.strategy << ',';
+        result.toCSV(row);
+        row << '\n';
+        rows[i] = row.getContents();
+    });
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run &run = runs[i];
+
+        if (run.scenario == 1 && optimal[run.dataset] < run.strategy)
+            rows[i].clear();
+    }
+
+    FileWriter out{DATASETS_PATH + OUTPUT_FILE};
+    out << OUTPUT_HEADER;
+
+    for (const auto &row : rows)
+        out << row;
+
+#ifdef INSTRUMENTATION
+    // Loading a dataset is written as scenario 0
+    FileWriter instrumentation{DATASETS_PATH + INSTRUMENTATION_FILE};
+    instrumentation << "dataset,scenario,heuristic,";
+    Metrics::headerCSV(instrumentation);
+    instrumentation << '\n';
+
+    for (size_t d = 0; d < names.size(); ++d) {
+        instrumentation << names[d] << ",0,0,";
+        loads[d].toCSV(instrumentation);
+        instrumentation << '\n';
+    }
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+        const Run &run = runs[i];
+
+        if (rows[i].empty())
+            continue;
 
-        out << name << ',' << 3 << ',' << 1 << ',' << result.toCSV() << '\n';
+        instrumentation << names[run.dataset] << ',' << run.scenario << ','
+                        << run.strategy << ',';
+        metrics[i].toCSV(instrumentation);
+        instrumentation << '\n';
     }
+#endif
 }
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -8,10 +11,12 @@
 #include "../includes/constants.hpp"
 #include "../includes/dataset.hpp"
 #include "../includes/order.hpp"
+#include "../includes/orderstream.hpp"
 #include "../includes/scenarios.hpp"
 #include "../includes/ui.hpp"
 #include "../includes/utils.hpp"
 #include "../includes/van.hpp"
+#include "../includes/views.hpp"
 
 template <class T>
 std::optional<T> UserInterface::optionsMenu(const Options<T> &options) {
@@ -129,6 +134,12 @@ void UserInterface::show(Dataset &dataset) {
     case Menu::GENERATE_DATASET:
         generateDatasetMenu(dataset);
         break;
+    case Menu::CONVERT_DATASET:
+        convertDatasetMenu();
+        break;
+    case Menu::STREAM_ORDERS:
+        streamOrdersMenu(dataset);
+        break;
 
     case Menu::SCENARIO_ONE:
         scenarioOneMenu(dataset);
@@ -149,6 +160,9 @@ void UserInterface::show(Dataset &dataset) {
     case Menu::RESULTS_VANS:
         resultsVansMenu();
         break;
+    case Menu::RESULTS_ORDERS:
+        resultsOrdersMenu();
+        break;
 
     case Menu::EXIT:
     default:
@@ -170,13 +184,39 @@ void UserInterface::mainMenu() {
         {"Choose dataset", Menu::CHOOSE_DATASET},
         {"Choose scenario", Menu::CHOOSE_SCENARIO},
         {"Generate dataset", Menu::GENERATE_DATASET},
+        {"Convert dataset to binary", Menu::CONVERT_DATASET},
+        {"Pack orders from a file", Menu::STREAM_ORDERS},
     });
     currentMenu = menu.value_or(currentMenu);
 }
 
-template <class T>
-void UserInterface::paginatedMenu(const std::vector<T> &items) {
+/**
+ * @return The id of each order of a table.
+ */
+static std::span<const uint32_t> _getIds(const OrderTable &orders) {
+    return orders.getIds();
+}
+
+/**
+ * @return The id of each order of a result, in the order they are listed.
+ */
+static std::span<const uint32_t> _getIds(const ResultOrdersView &orders) {
+    return orders.getIds();
+}
+
+/**
+ * @return The id of each van of a list.
+ */
+static std::vector<uint32_t> _getIds(const std::vector<Van> &vans) {
+    std::vector<uint32_t> ids(vans.size());
+    std::transform(vans.begin(), vans.end(), ids.begin(),
+                   [](const Van &van) { return van.getId(); });
+    return ids;
+}
+
+template <class T> void UserInterface::paginatedMenu(const T &items) {
     static unsigned int page{0};
+    static std::optional<IdIndex> index{};
 
     unsigned int pages = ceil((float)items.size() / ITEMS_PER_PAGE);
 
@@ -186,19 +226,45 @@ void UserInterface::paginatedMenu(const std::vector<T> &items) {
         return;
     }
 
-    for (auto i{items.begin() + page * ITEMS_PER_PAGE},
-         end{page == pages - 1 ? items.end()
-                               : items.begin() + (page + 1) * ITEMS_PER_PAGE};
+    for (size_t i{page * ITEMS_PER_PAGE},
+         end{std::min<size_t>(items.size(), (page + 1) * ITEMS_PER_PAGE)};
          i < end; ++i)
-        std::cout << *i << std::endl;
+        std::cout << items[i] << std::endl;
 
     std::cout << "\nPage " << page + 1 << " of " << pages;
-    auto option =
-        getStringInput("\nPress enter for next page, or 'q' to exit ");
+    auto option = getStringInput("\nPress enter for next page, 'p' for the "
+                                 "previous one, an id to go to its page, "
+                                 "or 'q' to exit ");
+
+    uint32_t id;
+    auto [end, ec] =
+        std::from_chars(option.data(), option.data() + option.size(), id);
+
+    if (ec == std::errc{} && end == option.data() + option.size()) {
+        // Only built when needed, most lists are never searched
+        auto ids = _getIds(items);
+        if (!index)
+            index.emplace(ids);
+
+        std::optional<size_t> position = index->find(ids, id);
+
+        if (position)
+            page = *position / ITEMS_PER_PAGE;
+        else
+            errorMessage = "No item with that id!\n";
+
+        return;
+    }
+
+    if (option == "p" || option == "P") {
+        page = page == 0 ? 0 : page - 1;
+        return;
+    }
 
     if ((option == "q" || option == "Q") || (++page == pages)) {
         currentMenu = Menu::MAIN;
         page = 0;
+        index.reset();
     }
 }
 
@@ -287,10 +353,73 @@ void UserInterface::generateDatasetMenu(Dataset &dataset) {
     params.maxVanCost =
         getUnsignedInput("Maximum cost for vans: ", params.minVanCost);
 
+    params.seed = getUnsignedInput("Seed for the random numbers: ");
+
     currentMenu = Menu::MAIN;
     dataset = Dataset::generate(name, params);
 }
 
+void UserInterface::convertDatasetMenu() {
+    Options<std::string> options{{"Go back", ""}};
+
+    auto datasets = Dataset::getAvailableDatasets();
+    std::transform(
+        datasets.begin(), datasets.end(), std::back_inserter(options),
+        [](const std::string &n) -> Options<std::string>::value_type {
+            return {n, n};
+        });
+
+    const auto selection = optionsMenu(options);
+
+    if (!selection.has_value())
+        return;
+
+    currentMenu = Menu::MAIN;
+
+    if (selection == "")
+        return;
+
+    if (Dataset::convertToBinary(selection.value()))
+        std::cout << GREEN_TEXT << "Converted " << selection.value()
+                  << RESET_FORMATTING << '\n';
+    else
+        std::cout << RED_TEXT << "Could not convert " << selection.value()
+                  << RESET_FORMATTING << '\n';
+
+    getStringInput("Press enter to continue ");
+}
+
+void UserInterface::streamOrdersMenu(Dataset &dataset) {
+    auto selection = optionsMenu<std::optional<StreamStrategy>>({
+        {"Go back", {}},
+        {"First fit", StreamStrategy::FIRST_FIT},
+        {"Best fit", StreamStrategy::BEST_FIT},
+    });
+
+    if (!selection.has_value()) // Error while getting option
+        return;
+
+    if (!selection.value().has_value()) { // User wants to go back
+        currentMenu = Menu::MAIN;
+        return;
+    }
+
+    std::ifstream file{getStringInput("Orders file: ")};
+
+    if (!file.is_open()) {
+        errorMessage = "Could not open the file!\n";
+        return;
+    }
+
+    try {
+        result = packOrderStream(file, dataset.getVans(),
+                                 selection.value().value());
+        currentMenu = Menu::RESULTS;
+    } catch (const std::invalid_argument &) {
+        errorMessage = "Malformed orders file!\n";
+    }
+}
+
 void UserInterface::scenarioOneMenu(Dataset &dataset) {
     auto selection = optionsMenu<std::optional<Scenario1Strategy>>({
         {"Go back", {}},
@@ -300,6 +429,12 @@ void UserInterface::scenarioOneMenu(Dataset &dataset) {
         {"Optimize using weight - descending", Scenario1Strategy::WEIGHT_DESC},
         {"Optimize using area   - ascending", Scenario1Strategy::AREA_ASC},
         {"Optimize using area   - descending", Scenario1Strategy::AREA_DESC},
+        {"Best fit decreasing", Scenario1Strategy::BEST_FIT},
+        {"Worst fit decreasing", Scenario1Strategy::WORST_FIT},
+        {"Best of many shuffled runs", Scenario1Strategy::MULTI_START},
+        {"Vector packing - dot product", Scenario1Strategy::DOT_PRODUCT},
+        {"Vector packing - L2 norm", Scenario1Strategy::L2_NORM},
+        {"Improve by moving orders", Scenario1Strategy::LOCAL_SEARCH},
     });
 
     if (!selection.has_value()) // Error while getting option
@@ -310,7 +445,7 @@ void UserInterface::scenarioOneMenu(Dataset &dataset) {
         return;
     }
 
-    result = scenario1(dataset, selection.value().value());
+    result = runScenario(dataset, 1, (int)selection.value().value());
     currentMenu = Menu::RESULTS;
 }
 
@@ -323,6 +458,9 @@ void UserInterface::scenarioTwoMenu(Dataset &dataset) {
         {"Optimize using weight - descending", Scenario2Strategy::WEIGHT_DESC},
         {"Optimize using area   - ascending", Scenario2Strategy::AREA_ASC},
         {"Optimize using area   - descending", Scenario2Strategy::AREA_DESC},
+        {"Optimize profit", Scenario2Strategy::PROFIT},
+        {"Best of many shuffled runs", Scenario2Strategy::MULTI_START},
+        {"Improve by moving orders", Scenario2Strategy::LOCAL_SEARCH},
     });
 
     if (!selection.has_value()) // Error while getting option
@@ -333,12 +471,26 @@ void UserInterface::scenarioTwoMenu(Dataset &dataset) {
         return;
     }
 
-    result = scenario2(dataset, selection.value().value());
+    result = runScenario(dataset, 2, (int)selection.value().value());
     currentMenu = Menu::RESULTS;
 }
 
 void UserInterface::scenarioThreeMenu(Dataset &dataset) {
-    result = scenario3(dataset);
+    auto selection = optionsMenu<std::optional<Scenario3Strategy>>({
+        {"Go back", {}},
+        {"Deliver the quickest orders", Scenario3Strategy::QUICKEST_FIRST},
+        {"Deliver the most rewarding orders", Scenario3Strategy::MAX_REWARD},
+    });
+
+    if (!selection.has_value()) // Error while getting option
+        return;
+
+    if (!selection.value().has_value()) { // User wants to go back
+        currentMenu = Menu::CHOOSE_SCENARIO;
+        return;
+    }
+
+    result = runScenario(dataset, 3, (int)selection.value().value());
     currentMenu = Menu::RESULTS;
 }
 
@@ -352,19 +504,29 @@ void UserInterface::allScenariosMenu() {
 void UserInterface::resultsMenu() {
     std::cout << "Used " << result.vans.size() << " vans\n"
               << "Dispatched " << result.ordersDispatched << " orders, "
-              << result.remainingOrders.size() << " remain\n"
+              << result.ordersRemaining << " remain\n"
               << "Delivery efficiency: " << (result.efficiency * 100) << "%\n"
               << "Average delivery time: "
               << ((double)result.deliveryTime / result.ordersDispatched)
               << "s\n"
               << "Spent " << result.cost << "€ on vans\n"
               << "Received " << result.reward << "€ from orders\n"
-              << "Total profit: " << result.profit << "€\n"
-              << "Took " << result.runtime.count() << "µs\n\n";
+              << "Total profit: " << result.profit << "€\n";
+
+    if (result.gap)
+        std::cout << "At most " << (*result.gap * 100)
+                  << "% from the best possible\n";
+
+    if (result.cached)
+        std::cout << "Found in the cache in " << result.runtime.count()
+                  << "µs\n\n";
+    else
+        std::cout << "Took " << result.runtime.count() << "µs\n\n";
 
     auto menu = optionsMenu<Menu>({
         {"Continue", Menu::MAIN},
         {"See vans", Menu::RESULTS_VANS},
+        {"See orders", Menu::RESULTS_ORDERS},
     });
     currentMenu = menu.value_or(currentMenu);
 }
@@ -373,3 +535,8 @@ void UserInterface::resultsVansMenu() {
     std::cout << "ID\tVolume\tWeight\tCost\tOrders\n" << std::left;
     paginatedMenu(result.vans);
 }
+
+void UserInterface::resultsOrdersMenu() {
+    std::cout << "Van\tID\tVolume\tWeight\tReward\tDuration\n";
+    paginatedMenu(ResultOrdersView{result});
+}
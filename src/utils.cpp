@@ -1,3 +1,9 @@
+#include <charconv>
+#include <stdexcept>
+
+#include "../includes/constants.hpp"
+#include "../includes/filewriter.hpp"
+#include "../includes/random.hpp"
 #include "../includes/utils.hpp"
 
 std::vector<std::string> split(std::string str, char sep) {
@@ -17,6 +23,128 @@ std::vector<std::string> split(std::string str, char sep) {
     return final;
 }
 
+void parseColumns(std::string_view text,
+                  std::initializer_list<std::vector<uint32_t> *> columns,
+                  bool header) {
+    const char *p = text.data(), *end = p + text.size();
+
+    // Every line but the header holds a row, and the last one may not end with
+    // a newline
+    size_t rows = std::count(p, end, '\n') + !header;
+    for (std::vector<uint32_t> *column : columns)
+        column->reserve(column->size() + rows);
+
+    auto skipBlanks = [&]() {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+    };
+    auto skipLine = [&]() {
+        p = std::find(p, end, '\n');
+        if (p != end)
+            ++p;
+    };
+
+    if (header)
+        skipLine(); // ignore dataset header
+
+    while (p != end) {
+        skipBlanks();
+
+        if (p == end || *p == '\n') {
+            skipLine();
+            continue;
+        }
+
+        for (std::vector<uint32_t> *column : columns) {
+            skipBlanks();
+
+            uint32_t value;
+            auto [next, ec] = std::from_chars(p, end, value);
+
+            if (ec != std::errc{})
+                throw std::invalid_argument("Malformed dataset line");
+
+            column->push_back(value);
+            p = next;
+        }
+
+        skipLine();
+    }
+}
+
+bool generateColumns(
+    const std::string &path, std::string_view header, size_t rows,
+    uint64_t seed,
+    std::initializer_list<std::pair<uint32_t, uint32_t>> ranges,
+    std::initializer_list<std::vector<uint32_t> *> columns) {
+    FileWriter file{path};
+
+    if (!file.good())
+        return false;
+
+    file << header;
+
+    std::vector<std::pair<uint32_t, uint32_t>> bounds{ranges};
+    std::vector<std::vector<uint32_t> *> output{columns};
+
+    for (std::vector<uint32_t> *column : output)
+        column->resize(rows);
+
+    // Enough for the longest number and its separator
+    const size_t lineSize = output.size() * 11;
+    const size_t blocks = (rows + GENERATOR_BLOCK_SIZE - 1) / GENERATOR_BLOCK_SIZE;
+    const size_t threads = getThreadCount();
+
+    std::vector<std::string> texts(threads);
+
+    // A round of blocks is generated in parallel, then written in order
+    for (size_t first = 0; first < blocks; first += threads) {
+        size_t count = std::min(threads, blocks - first);
+
+        parallelFor(count, [&](size_t k) {
+            size_t block = first + k;
+            size_t begin = block * GENERATOR_BLOCK_SIZE;
+            size_t end = std::min(rows, begin + GENERATOR_BLOCK_SIZE);
+
+            SplitMix64 rng{seed, block};
+
+            std::string &text = texts[k];
+            text.resize((end - begin) * lineSize);
+            char *p = text.data();
+
+            for (size_t row = begin; row < end; ++row) {
+                for (size_t c = 0; c < output.size(); ++c) {
+                    uint32_t value =
+                        rng.bounded(bounds[c].first, bounds[c].second);
+                    (*output[c])[row] = value;
+
+                    p = std::to_chars(p, p + 10, value).ptr;
+                    *p++ = c + 1 < output.size() ? ' ' : '\n';
+                }
+            }
+
+            text.resize(p - text.data());
+        });
+
+        for (size_t k = 0; k < count; ++k)
+            file << texts[k];
+    }
+
+    file.flush();
+    return file.good();
+}
+
+/** @brief How many threads parallelFor() uses by default, 0 for one per core. */
+static std::atomic<unsigned int> _threadCount{0};
+
+void setThreadCount(unsigned int threads) { _threadCount = threads; }
+
+unsigned int getThreadCount() {
+    unsigned int threads = _threadCount;
+    return threads != 0 ? threads
+                        : std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 void normalizeInput(std::string &input) {
     char last = 0;
     size_t i = 0;
@@ -1,86 +1,68 @@
-#include <fstream>
 #include <numeric>
-#include <random>
 
 #include "../includes/constants.hpp"
+#include "../includes/instrumentation.hpp"
+#include "../includes/mappedfile.hpp"
+#include "../includes/radixsort.hpp"
+#include "../includes/random.hpp"
 #include "../includes/utils.hpp"
 #include "../includes/van.hpp"
 
-unsigned int Van::GLOBAL_ID = 1;
+std::atomic<unsigned int> Van::GLOBAL_ID = 1;
 
 Van::Van(unsigned int maxVol, unsigned int maxWeight, unsigned int cost)
     : maxVolume(maxVol), currentVolume(0), maxWeight(maxWeight),
-      currentWeight(0), cost(cost), id(Van::GLOBAL_ID++){};
+      currentWeight(0), cost(cost), id(Van::GLOBAL_ID++), orderCount(0){};
 
 unsigned int Van::getMaxVolume() const { return this->maxVolume; };
 unsigned int Van::getMaxWeight() const { return this->maxWeight; };
 unsigned int Van::getCost() const { return this->cost; };
 unsigned int Van::getCurrentVolume() const { return this->currentVolume; };
 unsigned int Van::getCurrentWeight() const { return this->currentWeight; };
-std::vector<Order> Van::getOrders() const { return this->orders; };
+unsigned int Van::getOrderCount() const { return this->orderCount; };
+unsigned int Van::getId() const { return this->id; };
 
-Van Van::from(const std::vector<std::string> &tokens) {
-    unsigned int maxVol = std::stoul(tokens.at(0));
-    unsigned int maxWeight = std::stoul(tokens.at(1));
-    unsigned int cost = std::stoul(tokens.at(2));
-
-    return Van{maxVol, maxWeight, cost};
-}
-
-std::vector<Van> Van::processDataset(const std::string &path) {
+std::vector<Van> Van::fromColumns(const std::vector<uint32_t> &maxVolumes,
+                                  const std::vector<uint32_t> &maxWeights,
+                                  const std::vector<uint32_t> &costs) {
     GLOBAL_ID = 1;
 
-    std::ifstream dataset_file{DATASETS_PATH + path + VANS_FILE};
-
-    if (!dataset_file.is_open())
-        return {};
-
-    std::string line;
     std::vector<Van> result;
+    result.reserve(costs.size());
 
-    std::getline(dataset_file, line); // ignore dataset header
-
-    while (std::getline(dataset_file, line))
-        result.push_back(Van::from(split(line, ' ')));
+    for (size_t i = 0; i < costs.size(); ++i)
+        result.emplace_back(maxVolumes[i], maxWeights[i], costs[i]);
 
     return result;
 }
 
-std::vector<Van> Van::generateDataset(const std::string &name,
-                                      const DatasetGenerationParams &params) {
-    std::vector<Van> vans{params.numberOfVans, {0, 0, 0}};
-
-    GLOBAL_ID = 1;
-
-    std::ofstream dataset_file{DATASETS_PATH + name + VANS_FILE};
+std::vector<Van> Van::processDataset(const std::string &path) {
+    MappedFile dataset_file{DATASETS_PATH + path + VANS_FILE};
 
-    if (!dataset_file.is_open())
+    if (!dataset_file.isOpen())
         return {};
 
-    dataset_file << VANS_HEADER;
-
-    // Setup random generators
-    std::random_device rd{};
-    std::mt19937 gen{rd()};
+    std::vector<uint32_t> maxVolumes, maxWeights, costs;
+    parseColumns(dataset_file.getContents(),
+                 {&maxVolumes, &maxWeights, &costs});
 
-    // Generate vans
-    std::uniform_int_distribution vanWeightDist{params.minVanWeight,
-                                                params.maxVanWeight},
-        vanVolumeDist{params.minVanVolume, params.maxVanVolume},
-        vanCostDist{params.minVanCost, params.maxVanCost};
-
-    for (Van &v : vans) {
-        v = {
-            vanVolumeDist(gen),
-            vanWeightDist(gen),
-            vanCostDist(gen),
-        };
+    return fromColumns(maxVolumes, maxWeights, costs);
+}
 
-        dataset_file << v.maxVolume << ' ' << v.maxWeight << ' ' << v.cost
-                     << '\n';
-    }
+std::vector<Van> Van::generateDataset(const std::string &name,
+                                      const DatasetGenerationParams &params) {
+    std::vector<uint32_t> maxVolumes, maxWeights, costs;
+
+    // Scrambled, so the vans don't draw the same numbers as the orders
+    if (!generateColumns(DATASETS_PATH + name + VANS_FILE, VANS_HEADER,
+                         params.numberOfVans, splitmix64(params.seed),
+                         {{params.minVanVolume, params.maxVanVolume},
+                          {params.minVanWeight, params.maxVanWeight},
+                          {params.minVanCost, params.maxVanCost}},
+                         {&maxVolumes, &maxWeights, &costs}))
+        return {};
 
-    return vans;
+    return fromColumns(maxVolumes, maxWeights, costs);
 }
 
 std::ostream &operator<<(std::ostream &out, const Van &v) {
@@ -94,8 +76,8 @@ std::ostream &operator<<(std::ostream &out, const Van &v) {
 
     out << v.getMaxWeight() << '\t' << v.getCost();
 
-    if (!v.getOrders().empty())
-        out << '\t' << v.getOrders().size();
+    if (v.getOrderCount() > 0)
+        out << '\t' << v.getOrderCount();
 
     return out;
 }
@@ -109,42 +91,41 @@ bool Van::addOrder(const Order &order) {
     if (!canFit(order))
         return false;
 
-    orders.push_back(order);
+    INSTRUMENT_COUNT(PLACEMENTS, 1);
+
+    ++orderCount;
     this->currentVolume += order.getVolume();
     this->currentWeight += order.getWeight();
     return true;
 }
 
-bool Van::compareByVolume(const Van &v1, const Van &v2) {
-    if (v1.getMaxVolume() == v2.getMaxVolume()) {
-        return v1.getMaxWeight() > v2.getMaxWeight();
-    }
-    return v1.getMaxVolume() > v2.getMaxVolume();
+void Van::removeOrder(const Order &order) {
+    --orderCount;
+    this->currentVolume -= order.getVolume();
+    this->currentWeight -= order.getWeight();
+}
+
+uint64_t Van::keyByVolume(const Van &v) {
+    return ~((uint64_t)v.getMaxVolume() << 32 | v.getMaxWeight());
 }
 
-bool Van::compareByWeight(const Van &v1, const Van &v2) {
-    if (v1.getMaxWeight() == v2.getMaxWeight()) {
-        return v1.getMaxVolume() > v2.getMaxVolume();
-    }
-    return v1.getMaxWeight() > v2.getMaxWeight();
+uint64_t Van::keyByWeight(const Van &v) {
+    return ~((uint64_t)v.getMaxWeight() << 32 | v.getMaxVolume());
 }
 
-bool Van::compareByArea(const Van &v1, const Van &v2) {
-    return v1.getMaxVolume() * v1.getMaxWeight() >
-           v2.getMaxVolume() * v2.getMaxWeight();
+uint64_t Van::keyByArea(const Van &v) {
+    return ~((uint64_t)v.getMaxVolume() * v.getMaxWeight());
 }
 
-bool Van::compareByVolumeOverCost(const Van &v1, const Van &v2) {
-    return (double)v1.getMaxVolume() / v1.getCost() >
-           (double)v2.getMaxVolume() / v2.getCost();
+uint64_t Van::keyByVolumeOverCost(const Van &v) {
+    return descendingRatioKey((double)v.getMaxVolume() / v.getCost());
 }
 
-bool Van::compareByWeightOverCost(const Van &v1, const Van &v2) {
-    return (double)v1.getMaxWeight() / v1.getCost() >
-           (double)v2.getMaxWeight() / v2.getCost();
+uint64_t Van::keyByWeightOverCost(const Van &v) {
+    return descendingRatioKey((double)v.getMaxWeight() / v.getCost());
 }
 
-bool Van::compareByAreaOverCost(const Van &v1, const Van &v2) {
-    return (double)v1.getMaxVolume() * v1.getMaxWeight() / v1.getCost() >
-           (double)v2.getMaxVolume() * v2.getMaxWeight() / v2.getCost();
+uint64_t Van::keyByAreaOverCost(const Van &v) {
+    return descendingRatioKey((double)v.getMaxVolume() * v.getMaxWeight() /
+                              v.getCost());
 }
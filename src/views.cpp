@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <numeric>
+
+#include "../includes/radixsort.hpp"
+#include "../includes/views.hpp"
+
+IdIndex::IdIndex(std::span<const uint32_t> ids) {
+    if (std::is_sorted(ids.begin(), ids.end()))
+        return;
+
+    sorted.assign(ids.begin(), ids.end());
+    positions.resize(ids.size());
+    std::iota(positions.begin(), positions.end(), 0);
+
+    radixSort(sorted, positions);
+}
+
+std::optional<size_t> IdIndex::find(std::span<const uint32_t> ids,
+                                    uint32_t id) const {
+    if (sorted.empty()) {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+
+        if (it == ids.end() || *it != id)
+            return {};
+
+        return it - ids.begin();
+    }
+
+    auto it = std::lower_bound(sorted.begin(), sorted.end(), id);
+
+    if (it == sorted.end() || *it != id)
+        return {};
+
+    return positions[it - sorted.begin()];
+}
+
+std::ostream &operator<<(std::ostream &out, const ResultOrderRow &row) {
+    if (row.van)
+        out << *row.van;
+    else
+        out << '-';
+
+    return out << '\t' << row.order;
+}
+
+ResultOrdersView::ResultOrdersView(const ScenarioResult &result)
+    : result(&result) {}
+
+size_t ResultOrdersView::size() const { return result->orders.size(); }
+
+ResultOrderRow ResultOrdersView::operator[](size_t i) const {
+    // The last van whose orders start at or before i
+    auto it = std::upper_bound(result->offsets.begin(), result->offsets.end(),
+                               i);
+    size_t van = it - result->offsets.begin() - 1;
+
+    if (van < result->vans.size())
+        return {result->vans[van].getId(), result->orders[i]};
+
+    return {{}, result->orders[i]};
+}
+
+std::span<const uint32_t> ResultOrdersView::getIds() const {
+    return result->orders.getIds();
+}